@@ -0,0 +1,151 @@
+/*
+    ASCOM Alpaca Protocol Implementation for ESP32 Celestron Focuser Controller
+    Plain C++11 with no web server types, so the host tests in test/ build it too
+
+    Copyright (C) 2024
+*/
+
+#include "alpaca_protocol.h"
+
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <strings.h>
+
+static AlpacaOutcome alpacaOutcome(uint16_t http, uint16_t error, const char* message) {
+    AlpacaOutcome outcome = {http, error, message};
+    return outcome;
+}
+
+// ============================================================================
+// Requests
+// ============================================================================
+
+AlpacaOutcome alpacaCheckRequest(AlpacaParam type, const char* text, bool needsConnection,
+                                 bool sessionOpen, bool focuserConnected, AlpacaArgument &argument) {
+    argument.number = 0;
+    argument.flag = false;
+
+    if (needsConnection && !sessionOpen) {
+        return alpacaOutcome(ALPACA_HTTP_OK, ALPACA_NOT_CONNECTED, "Not connected");
+    }
+    if (needsConnection && !focuserConnected) {
+        return alpacaOutcome(ALPACA_HTTP_OK, ALPACA_NOT_CONNECTED, "Focuser not connected");
+    }
+    if (type == ALPACA_PARAM_NONE) {
+        return alpacaOutcome(ALPACA_HTTP_OK, ALPACA_OK, "");
+    }
+    if (!text) {
+        return alpacaOutcome(ALPACA_HTTP_BAD_REQUEST, ALPACA_OK, "Missing parameter");
+    }
+
+    if (type == ALPACA_PARAM_INT) {
+        char *end;
+        errno = 0;
+        long number = strtol(text, &end, 10);
+        if (*text == '\0' || *end != '\0') {
+            return alpacaOutcome(ALPACA_HTTP_BAD_REQUEST, ALPACA_OK, "Parameter is not an integer");
+        }
+        if (number < 0) {
+            return alpacaOutcome(ALPACA_HTTP_OK, ALPACA_INVALID_VALUE, "Value must not be negative");
+        }
+        if (errno == ERANGE || (unsigned long)number > 0xFFFFFFFFUL) {
+            return alpacaOutcome(ALPACA_HTTP_OK, ALPACA_INVALID_VALUE, "Value out of range");
+        }
+        argument.number = (uint32_t)number;
+        return alpacaOutcome(ALPACA_HTTP_OK, ALPACA_OK, "");
+    }
+
+    // Booleans are case-insensitive ("True" from .NET clients)
+    if (strcasecmp(text, "true") == 0) {
+        argument.flag = true;
+    } else if (strcasecmp(text, "false") != 0) {
+        return alpacaOutcome(ALPACA_HTTP_BAD_REQUEST, ALPACA_OK, "Parameter is not a boolean");
+    }
+    return alpacaOutcome(ALPACA_HTTP_OK, ALPACA_OK, "");
+}
+
+AlpacaOutcome alpacaCommandOutcome(bool succeeded, bool invalid, const char* message, bool hasValue) {
+    if (invalid) {
+        return alpacaOutcome(ALPACA_HTTP_OK, ALPACA_INVALID_VALUE, message ? message : "Invalid value");
+    }
+    if (!succeeded) {
+        return alpacaOutcome(ALPACA_HTTP_OK, ALPACA_UNSPECIFIED_ERROR, "Focuser command failed");
+    }
+    if (!hasValue) {
+        // Temperature is absent until a sample has arrived
+        return alpacaOutcome(ALPACA_HTTP_OK, ALPACA_NOT_IMPLEMENTED, "Value not available");
+    }
+    return alpacaOutcome(ALPACA_HTTP_OK, ALPACA_OK, "");
+}
+
+uint32_t alpacaParseTransaction(const char* text) {
+    if (!text || *text < '0' || *text > '9') {
+        return 0;
+    }
+
+    char *end;
+    errno = 0;
+    unsigned long number = strtoul(text, &end, 10);
+    if (*end != '\0' || errno == ERANGE || number > 0xFFFFFFFFUL) {
+        return 0;
+    }
+    return (uint32_t)number;
+}
+
+// ============================================================================
+// Replies
+// ============================================================================
+
+static bool appendFormat(char* out, size_t size, size_t &length, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(out + length, size - length, format, args);
+    va_end(args);
+    if (written < 0 || (size_t)written >= size - length) {
+        return false;
+    }
+    length += written;
+    return true;
+}
+
+static bool appendString(char* out, size_t size, size_t &length, const char* text) {
+    // JSON string with quotes, backslashes and control characters escaped
+    if (!appendFormat(out, size, length, "\"")) {
+        return false;
+    }
+    for (const char *c = text; *c; c++) {
+        bool fits;
+        if (*c == '"' || *c == '\\') {
+            fits = appendFormat(out, size, length, "\\%c", *c);
+        } else if ((unsigned char)*c < 0x20) {
+            fits = appendFormat(out, size, length, "\\u%04x", (unsigned)(unsigned char)*c);
+        } else {
+            fits = appendFormat(out, size, length, "%c", *c);
+        }
+        if (!fits) {
+            return false;
+        }
+    }
+    return appendFormat(out, size, length, "\"");
+}
+
+size_t alpacaBuildReply(char* out, size_t size, uint32_t clientTransaction, uint32_t serverTransaction,
+                        uint16_t error, const char* message, const char* value) {
+    size_t length = 0;
+    if (size == 0) {
+        return 0;
+    }
+
+    bool fits = appendFormat(out, size, length, "{");
+    if (fits && value) {
+        fits = appendFormat(out, size, length, "\"Value\":%s,", value);
+    }
+    fits = fits && appendFormat(out, size, length, "\"ClientTransactionID\":%lu,\"ServerTransactionID\":%lu,"
+                                "\"ErrorNumber\":%u,\"ErrorMessage\":",
+                                (unsigned long)clientTransaction, (unsigned long)serverTransaction, (unsigned)error);
+    fits = fits && appendString(out, size, length, message ? message : "");
+    fits = fits && appendFormat(out, size, length, "}");
+    return fits ? length : 0;
+}
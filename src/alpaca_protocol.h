@@ -0,0 +1,88 @@
+/*
+    ASCOM Alpaca Protocol for ESP32 Celestron Focuser Controller
+    Parameter parsing, error mapping and reply building for the Alpaca server
+
+    Copyright (C) 2024
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Alpaca error numbers (reported with HTTP 200)
+#define ALPACA_OK 0x000
+#define ALPACA_NOT_IMPLEMENTED 0x400
+#define ALPACA_INVALID_VALUE 0x401
+#define ALPACA_NOT_CONNECTED 0x407
+#define ALPACA_UNSPECIFIED_ERROR 0x4FF
+
+// HTTP status for malformed requests (plain text reason, no Alpaca reply)
+#define ALPACA_HTTP_OK 200
+#define ALPACA_HTTP_BAD_REQUEST 400
+
+/**
+ * Alpaca Parameter Types
+ */
+enum AlpacaParam : uint8_t {
+    ALPACA_PARAM_NONE,
+    ALPACA_PARAM_INT,
+    ALPACA_PARAM_BOOL
+};
+
+/**
+ * Alpaca Outcome
+ * How a device request is answered: HTTP 400 with message as the body, or
+ * HTTP 200 with an Alpaca error number (ALPACA_OK to go ahead)
+ */
+struct AlpacaOutcome {
+    uint16_t http;
+    uint16_t error;
+    const char* message;
+};
+
+/**
+ * Alpaca Argument
+ * A parsed route parameter, ready to become a registry command argument
+ */
+struct AlpacaArgument {
+    uint32_t number;
+    bool flag;
+};
+
+/**
+ * Alpaca Session
+ * Connected state of the Alpaca client. Kept apart from the focuser's own
+ * connection so Connected=false does not take the focuser from WebSocket
+ * and serial users. Written on the TCP and AUX tasks, hence atomic.
+ */
+class AlpacaSession {
+public:
+    AlpacaSession() : _open(false) {}
+
+    void open() { _open = true; }
+    void close() { _open = false; }
+    bool isOpen() const { return _open; }
+    bool connected(bool focuserConnected) const { return _open && focuserConnected; }
+
+private:
+    std::atomic<bool> _open;
+};
+
+// Checks a device request before its command is queued. text is the route
+// parameter as received (nullptr when absent); argument is filled on success
+AlpacaOutcome alpacaCheckRequest(AlpacaParam type, const char* text, bool needsConnection,
+                                 bool sessionOpen, bool focuserConnected, AlpacaArgument &argument);
+
+// Maps a finished registry command to its reply. message is the handler's
+// reason for an invalid value; hasValue is false when the route's field is absent
+AlpacaOutcome alpacaCommandOutcome(bool succeeded, bool invalid, const char* message, bool hasValue);
+
+// ClientTransactionID as an unsigned 32 bit number, 0 when absent or malformed
+uint32_t alpacaParseTransaction(const char* text);
+
+// Writes the reply JSON. value is a serialized JSON fragment or nullptr for
+// none. Returns the length, or 0 when the reply does not fit in size
+size_t alpacaBuildReply(char* out, size_t size, uint32_t clientTransaction, uint32_t serverTransaction,
+                        uint16_t error, const char* message, const char* value);
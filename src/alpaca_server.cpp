@@ -0,0 +1,304 @@
+/*
+    ASCOM Alpaca Server Implementation for ESP32 Celestron Focuser Controller
+
+    Copyright (C) 2024
+*/
+
+#include "alpaca_server.h"
+
+// Global Alpaca server instance
+AlpacaServer alpaca;
+
+std::atomic<uint32_t> AlpacaServer::_serverTransaction(0);
+AlpacaSession AlpacaServer::_session;
+
+// Device methods that run a focuser command on the AUX task
+static const AlpacaRoute ALPACA_ROUTES[] = {
+    {"position",     HTTP_GET, "focuser:status",      "position",    nullptr,     nullptr,    ALPACA_PARAM_NONE, true},
+    {"ismoving",     HTTP_GET, "focuser:status",      "moving",      nullptr,     nullptr,    ALPACA_PARAM_NONE, true},
+    {"maxstep",      HTTP_GET, "focuser:getLimits",   "max",         nullptr,     nullptr,    ALPACA_PARAM_NONE, false},
+    {"maxincrement", HTTP_GET, "focuser:getLimits",   "max",         nullptr,     nullptr,    ALPACA_PARAM_NONE, false},
+    {"tempcomp",     HTTP_GET, "focuser:getTempComp", "enabled",     nullptr,     nullptr,    ALPACA_PARAM_NONE, false},
+    {"temperature",  HTTP_GET, "focuser:getTempComp", "temperature", nullptr,     nullptr,    ALPACA_PARAM_NONE, false},
+    {"connected",    HTTP_PUT, "focuser:connect",     nullptr,       "Connected", nullptr,    ALPACA_PARAM_BOOL, false},
+    {"move",         HTTP_PUT, "focuser:goto",        nullptr,       "Position",  "position", ALPACA_PARAM_INT,  true},
+    {"halt",         HTTP_PUT, "focuser:stop",        nullptr,       nullptr,     nullptr,    ALPACA_PARAM_NONE, true},
+    {"tempcomp",     HTTP_PUT, "focuser:setTempComp", nullptr,       "TempComp",  "enabled",  ALPACA_PARAM_BOOL, false},
+};
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+AlpacaServer::AlpacaServer() {
+    _wifi = nullptr;
+    _uniqueId[0] = '\0';
+}
+
+// ============================================================================
+// Initialization
+// ============================================================================
+
+bool AlpacaServer::begin(WiFiManager &wifi) {
+    AsyncWebServer *server = wifi.getWebServer();
+    if (!server) {
+        Serial.println("ERROR: Alpaca server needs the web server running");
+        return false;
+    }
+    _wifi = &wifi;
+
+    // Stable per-board id for configureddevices
+    uint64_t mac = ESP.getEfuseMac();
+    snprintf(_uniqueId, sizeof(_uniqueId), "focuser-%04x%08lx",
+             (unsigned)(mac >> 32) & 0xFFFF, (unsigned long)(mac & 0xFFFFFFFF));
+
+    _setupDeviceRoutes(server);
+    _setupManagementRoutes(server);
+
+    if (_discovery.listen(ALPACA_DISCOVERY_PORT)) {
+        _discovery.onPacket([this](AsyncUDPPacket &packet) {
+            _onDiscovery(packet);
+        });
+    } else {
+        Serial.println("ERROR: Alpaca discovery failed to listen on port " + String(ALPACA_DISCOVERY_PORT));
+    }
+
+    Serial.println("INFO: Alpaca focuser available at " + String(ALPACA_DEVICE_PATH));
+    Serial.println("INFO: Alpaca discovery on UDP port " + String(ALPACA_DISCOVERY_PORT));
+    return true;
+}
+
+void AlpacaServer::setConnectedCallback(std::function<bool()> callback) {
+    _isConnected = callback;
+}
+
+// ============================================================================
+// Routes
+// ============================================================================
+
+void AlpacaServer::_setupDeviceRoutes(AsyncWebServer *server) {
+    for (uint8_t i = 0; i < sizeof(ALPACA_ROUTES) / sizeof(ALPACA_ROUTES[0]); i++) {
+        String path = String(ALPACA_DEVICE_PATH) + ALPACA_ROUTES[i].method;
+        server->on(path.c_str(), ALPACA_ROUTES[i].http, [this, i](AsyncWebServerRequest *request) {
+            _handleDeviceRequest(request, i);
+        });
+    }
+
+    // Alpaca session state, separate from the focuser's own connection
+    server->on(ALPACA_DEVICE_PATH "connected", HTTP_GET, [this](AsyncWebServerRequest *request) {
+        _sendValue(request, _session.connected(_focuserConnected()));
+    });
+
+    // Constant properties are answered on the TCP task
+    server->on(ALPACA_DEVICE_PATH "absolute", HTTP_GET, [](AsyncWebServerRequest *request) {
+        _sendValue(request, true);
+    });
+    server->on(ALPACA_DEVICE_PATH "tempcompavailable", HTTP_GET, [](AsyncWebServerRequest *request) {
+        _sendValue(request, true);
+    });
+    server->on(ALPACA_DEVICE_PATH "interfaceversion", HTTP_GET, [](AsyncWebServerRequest *request) {
+        _sendValue(request, ALPACA_INTERFACE_VERSION);
+    });
+    server->on(ALPACA_DEVICE_PATH "name", HTTP_GET, [](AsyncWebServerRequest *request) {
+        _sendValue(request, ALPACA_DEVICE_NAME);
+    });
+    server->on(ALPACA_DEVICE_PATH "description", HTTP_GET, [](AsyncWebServerRequest *request) {
+        _sendValue(request, ALPACA_DEVICE_NAME " on the Celestron AUX bus");
+    });
+    server->on(ALPACA_DEVICE_PATH "driverinfo", HTTP_GET, [](AsyncWebServerRequest *request) {
+        _sendValue(request, ALPACA_DRIVER_INFO);
+    });
+    server->on(ALPACA_DEVICE_PATH "driverversion", HTTP_GET, [](AsyncWebServerRequest *request) {
+        _sendValue(request, ALPACA_DRIVER_VERSION);
+    });
+    server->on(ALPACA_DEVICE_PATH "supportedactions", HTTP_GET, [](AsyncWebServerRequest *request) {
+        JsonDocument value(&tcpJsonArena);
+        value.to<JsonArray>();
+        _sendReply(request, _clientTransaction(request), ALPACA_OK, "", value.as<JsonVariantConst>());
+    });
+
+    // Step size in microns is not known for Celestron focusers
+    server->on(ALPACA_DEVICE_PATH "stepsize", HTTP_GET, [](AsyncWebServerRequest *request) {
+        _sendError(request, ALPACA_NOT_IMPLEMENTED, "Step size is not known");
+    });
+    static const char* const UNSUPPORTED[] = {"action", "commandblind", "commandbool", "commandstring"};
+    for (uint8_t i = 0; i < sizeof(UNSUPPORTED) / sizeof(UNSUPPORTED[0]); i++) {
+        String path = String(ALPACA_DEVICE_PATH) + UNSUPPORTED[i];
+        server->on(path.c_str(), HTTP_PUT, [](AsyncWebServerRequest *request) {
+            _sendError(request, ALPACA_NOT_IMPLEMENTED, "Not implemented");
+        });
+    }
+}
+
+void AlpacaServer::_setupManagementRoutes(AsyncWebServer *server) {
+    server->on("/management/apiversions", HTTP_GET, [](AsyncWebServerRequest *request) {
+        JsonDocument value(&tcpJsonArena);
+        value.to<JsonArray>().add(1);
+        _sendReply(request, _clientTransaction(request), ALPACA_OK, "", value.as<JsonVariantConst>());
+    });
+    server->on("/management/v1/description", HTTP_GET, [](AsyncWebServerRequest *request) {
+        JsonDocument value(&tcpJsonArena);
+        JsonObject description = value.to<JsonObject>();
+        description["ServerName"] = ALPACA_DEVICE_NAME;
+        description["Manufacturer"] = ALPACA_MANUFACTURER;
+        description["ManufacturerVersion"] = ALPACA_DRIVER_VERSION;
+        description["Location"] = "";
+        _sendReply(request, _clientTransaction(request), ALPACA_OK, "", value.as<JsonVariantConst>());
+    });
+    server->on("/management/v1/configureddevices", HTTP_GET, [this](AsyncWebServerRequest *request) {
+        JsonDocument value(&tcpJsonArena);
+        JsonObject device = value.to<JsonArray>().add<JsonObject>();
+        device["DeviceName"] = ALPACA_DEVICE_NAME;
+        device["DeviceType"] = "Focuser";
+        device["DeviceNumber"] = 0;
+        device["UniqueID"] = (const char*)_uniqueId;
+        _sendReply(request, _clientTransaction(request), ALPACA_OK, "", value.as<JsonVariantConst>());
+    });
+}
+
+void AlpacaServer::_handleDeviceRequest(AsyncWebServerRequest *request, uint8_t index) {
+    // Runs on the TCP task: validate, then hand the command to the AUX task
+    const AlpacaRoute &route = ALPACA_ROUTES[index];
+    const AsyncWebParameter *param = route.param ? _findParam(request, route.param) : nullptr;
+    AlpacaArgument argument;
+    AlpacaOutcome outcome = alpacaCheckRequest(route.type, param ? param->value().c_str() : nullptr,
+                                               route.needsConnection, _session.isOpen(), _focuserConnected(),
+                                               argument);
+    if (outcome.http != ALPACA_HTTP_OK) {
+        _sendBadRequest(request, outcome.message);
+        return;
+    }
+    if (outcome.error != ALPACA_OK) {
+        _sendError(request, outcome.error, outcome.message);
+        return;
+    }
+
+    // Disconnecting only ends the Alpaca session: WebSocket and serial users
+    // keep the focuser
+    if (route.type == ALPACA_PARAM_BOOL && !route.argument && !argument.flag) {
+        _session.close();
+        _sendError(request, ALPACA_OK, "");
+        return;
+    }
+
+    JsonDocument command(&tcpJsonArena);
+    command["command"] = route.command;
+    command["ClientTransactionID"] = _clientTransaction(request);
+    if (route.argument && route.type == ALPACA_PARAM_INT) {
+        command[route.argument] = argument.number;
+    } else if (route.argument) {
+        command[route.argument] = argument.flag;
+    }
+
+    if (_wifi->deferRequest(request, command, _completeDeviceRequest, index) != 0) {
+        _sendError(request, ALPACA_UNSPECIFIED_ERROR, "Server busy");
+    }
+}
+
+void AlpacaServer::_completeDeviceRequest(AsyncWebServerRequest *request, JsonDocument &command, CommandResult result,
+                                          JsonDocument &response, uint32_t tag) {
+    // Runs on the AUX task once the focuser command has finished
+    const AlpacaRoute &route = ALPACA_ROUTES[tag];
+    uint32_t clientTransaction = command["ClientTransactionID"] | 0UL;
+    JsonVariantConst value;
+    if (route.field) {
+        value = response[route.field].as<JsonVariantConst>();
+    }
+
+    AlpacaOutcome outcome = alpacaCommandOutcome(result == COMMAND_OK, result == COMMAND_INVALID,
+                                                 response["message"].as<const char*>(),
+                                                 !route.field || !value.isNull());
+    if (outcome.error != ALPACA_OK) {
+        _sendReply(request, clientTransaction, outcome.error, outcome.message);
+        return;
+    }
+
+    // The session opens once the focuser itself is connected
+    if (strcmp(route.command, "focuser:connect") == 0) {
+        _session.open();
+    }
+    _sendReply(request, clientTransaction, ALPACA_OK, "", value);
+}
+
+bool AlpacaServer::_focuserConnected() {
+    return !_isConnected || _isConnected();
+}
+
+// ============================================================================
+// Discovery
+// ============================================================================
+
+void AlpacaServer::_onDiscovery(AsyncUDPPacket &packet) {
+    // Runs on the UDP task: fixed reply, no shared state
+    size_t length = strlen(ALPACA_DISCOVERY_MESSAGE);
+    if (packet.length() < length || memcmp(packet.data(), ALPACA_DISCOVERY_MESSAGE, length) != 0) {
+        return;
+    }
+
+    char reply[32];
+    int replyLength = snprintf(reply, sizeof(reply), "{\"AlpacaPort\":%d}", WEB_SERVER_PORT);
+    packet.write((const uint8_t*)reply, replyLength);
+}
+
+// ============================================================================
+// Replies
+// ============================================================================
+
+void AlpacaServer::_sendReply(AsyncWebServerRequest *request, uint32_t clientTransaction, uint16_t error,
+                              const char* message, JsonVariantConst value) {
+    // Value is serialized on its own, then wrapped in the Alpaca fields
+    char serialized[ALPACA_VALUE_SIZE];
+    const char *fragment = nullptr;
+    if (!value.isNull() && measureJson(value) < sizeof(serialized)) {
+        serializeJson(value, serialized, sizeof(serialized));
+        fragment = serialized;
+    } else if (!value.isNull()) {
+        error = ALPACA_UNSPECIFIED_ERROR;
+        message = "Value too large";
+    }
+
+    char reply[ALPACA_REPLY_SIZE];
+    uint32_t serverTransaction = ++_serverTransaction;
+    if (alpacaBuildReply(reply, sizeof(reply), clientTransaction, serverTransaction, error, message, fragment) == 0) {
+        alpacaBuildReply(reply, sizeof(reply), clientTransaction, serverTransaction, ALPACA_UNSPECIFIED_ERROR,
+                         "Reply too large", nullptr);
+    }
+    request->send(ALPACA_HTTP_OK, "application/json", reply);
+}
+
+void AlpacaServer::_sendError(AsyncWebServerRequest *request, uint16_t error, const char* message) {
+    _sendReply(request, _clientTransaction(request), error, message);
+}
+
+template<typename T>
+void AlpacaServer::_sendValue(AsyncWebServerRequest *request, T value) {
+    // TCP task only
+    JsonDocument reply(&tcpJsonArena);
+    reply.set(value);
+    _sendReply(request, _clientTransaction(request), ALPACA_OK, "", reply.as<JsonVariantConst>());
+}
+
+void AlpacaServer::_sendBadRequest(AsyncWebServerRequest *request, const char* message) {
+    // Malformed requests get HTTP 400 with a plain text reason
+    request->send(ALPACA_HTTP_BAD_REQUEST, "text/plain", message);
+}
+
+// ============================================================================
+// Parameters
+// ============================================================================
+
+const AsyncWebParameter* AlpacaServer::_findParam(AsyncWebServerRequest *request, const char* name) {
+    // Query string for GET, form body for PUT
+    for (size_t i = 0; i < request->params(); i++) {
+        const AsyncWebParameter *param = request->getParam(i);
+        if (param->name().equalsIgnoreCase(name)) {
+            return param;
+        }
+    }
+    return nullptr;
+}
+
+uint32_t AlpacaServer::_clientTransaction(AsyncWebServerRequest *request) {
+    const AsyncWebParameter *param = _findParam(request, "ClientTransactionID");
+    return alpacaParseTransaction(param ? param->value().c_str() : nullptr);
+}
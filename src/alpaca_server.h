@@ -0,0 +1,94 @@
+/*
+    ASCOM Alpaca Server for ESP32 Celestron Focuser Controller
+    Alpaca Focuser API (IFocuserV3) on the web server plus UDP discovery
+
+    Copyright (C) 2024
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include <AsyncUDP.h>
+#include <atomic>
+#include "alpaca_protocol.h"
+#include "wifi_manager.h"
+
+// Alpaca Configuration
+#define ALPACA_DISCOVERY_PORT 32227
+#define ALPACA_DISCOVERY_MESSAGE "alpacadiscovery1"
+#define ALPACA_DEVICE_PATH "/api/v1/focuser/0/"
+#define ALPACA_INTERFACE_VERSION 3          // IFocuserV3
+#define ALPACA_DEVICE_NAME "Celestron Focuser"
+#define ALPACA_DRIVER_INFO "ESP32 Celestron AUX focuser controller"
+#define ALPACA_DRIVER_VERSION "1.0"
+#define ALPACA_MANUFACTURER "celestron-focuser"
+
+// Reply buffers (the serialized Value, and the whole reply around it)
+#define ALPACA_VALUE_SIZE 256
+#define ALPACA_REPLY_SIZE 512
+
+/**
+ * Alpaca Route
+ * A device method backed by a registry command run on the AUX task
+ */
+struct AlpacaRoute {
+    const char* method;                 // Path segment after ALPACA_DEVICE_PATH
+    WebRequestMethodComposite http;
+    const char* command;                // Registry command
+    const char* field;                  // Command response field returned as Value
+    const char* param;                  // Alpaca parameter (PUT methods)
+    const char* argument;               // Command argument the parameter becomes
+    AlpacaParam type;
+    bool needsConnection;               // NotConnected error until Connected=true or while the focuser is offline
+};
+
+/**
+ * Alpaca Server Class
+ * Device and management endpoints on the shared web server. Methods that
+ * touch the focuser are deferred to the AUX task like the REST API; constant
+ * properties are answered directly on the TCP task.
+ */
+class AlpacaServer {
+public:
+    // Constructor
+    AlpacaServer();
+
+    // Initialization (after WiFiManager::begin() has started the web server)
+    bool begin(WiFiManager &wifi);
+    void setConnectedCallback(std::function<bool()> callback);
+
+private:
+    WiFiManager* _wifi;
+    AsyncUDP _discovery;
+    std::function<bool()> _isConnected;
+    char _uniqueId[24];
+
+    // Shared with the AUX task completion
+    static std::atomic<uint32_t> _serverTransaction;
+    static AlpacaSession _session;
+
+    // Routes
+    void _setupDeviceRoutes(AsyncWebServer *server);
+    void _setupManagementRoutes(AsyncWebServer *server);
+    void _handleDeviceRequest(AsyncWebServerRequest *request, uint8_t index);
+    static void _completeDeviceRequest(AsyncWebServerRequest *request, JsonDocument &command, CommandResult result,
+                                       JsonDocument &response, uint32_t tag);
+    bool _focuserConnected();
+
+    // Discovery
+    void _onDiscovery(AsyncUDPPacket &packet);
+
+    // Replies
+    static void _sendReply(AsyncWebServerRequest *request, uint32_t clientTransaction, uint16_t error,
+                           const char* message, JsonVariantConst value = JsonVariantConst());
+    static void _sendError(AsyncWebServerRequest *request, uint16_t error, const char* message);
+    template<typename T> static void _sendValue(AsyncWebServerRequest *request, T value);
+    static void _sendBadRequest(AsyncWebServerRequest *request, const char* message);
+
+    // Parameters (names are case-insensitive)
+    static const AsyncWebParameter* _findParam(AsyncWebServerRequest *request, const char* name);
+    static uint32_t _clientTransaction(AsyncWebServerRequest *request);
+};
+
+// Global Alpaca server instance
+extern AlpacaServer alpaca;
@@ -0,0 +1,262 @@
+/*
+    AUX TCP Bridge Implementation for ESP32 Celestron Focuser Controller
+
+    Copyright (C) 2024
+*/
+
+#include "aux_bridge.h"
+
+// Global AUX bridge instance
+AuxBridge auxBridge;
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+AuxBridge::AuxBridge() : _server(AUX_BRIDGE_PORT) {
+    _client = nullptr;
+    _lock = nullptr;
+    _worker = nullptr;
+    _requestLength = 0;
+    _transactions = 0;
+    _dropped = 0;
+}
+
+// ============================================================================
+// Initialization
+// ============================================================================
+
+void AuxBridge::begin() {
+    _lock = xSemaphoreCreateMutex();
+
+    _server.onClient([](void *arg, AsyncClient *client) {
+        ((AuxBridge*)arg)->_onClient(client);
+    }, this);
+    _server.begin();
+
+    Serial.println("INFO: AUX bridge listening on TCP port " + String(AUX_BRIDGE_PORT));
+}
+
+void AuxBridge::setWorkerTask(TaskHandle_t task) {
+    _worker = task;
+}
+
+// ============================================================================
+// AUX Task
+// ============================================================================
+
+void AuxBridge::handle(AuxPort &port) {
+    uint8_t frames[AUX_BRIDGE_BUFFER_SIZE];
+
+    // Pipelined requests run back to back, bounded so the AUX task keeps moving
+    for (uint8_t burst = 0; burst < AUX_BRIDGE_MAX_BURST; burst++) {
+        size_t length = _takeFrames(frames, sizeof(frames));
+        if (length == 0) {
+            return;
+        }
+        _transact(port, frames, length);
+    }
+}
+
+// ============================================================================
+// Status
+// ============================================================================
+
+bool AuxBridge::isConnected() {
+    return _client != nullptr;
+}
+
+uint32_t AuxBridge::getTransactions() {
+    return _transactions;
+}
+
+uint32_t AuxBridge::getDropped() {
+    return _dropped;
+}
+
+// ============================================================================
+// TCP Task Callbacks
+// ============================================================================
+
+void AuxBridge::_onClient(AsyncClient *client) {
+    client->onDisconnect([](void *arg, AsyncClient *client) {
+        ((AuxBridge*)arg)->_onDisconnect(client);
+    }, this);
+
+    xSemaphoreTake(_lock, portMAX_DELAY);
+    bool busy = (_client != nullptr);
+    if (!busy) {
+        _client = client;
+        _requestLength = 0;
+    }
+    xSemaphoreGive(_lock);
+
+    // One bus, one client (like the Celestron WiFi module)
+    if (busy) {
+        client->close(true);
+        return;
+    }
+
+    // Small AUX frames must not wait for Nagle
+    client->setNoDelay(true);
+    client->onData([](void *arg, AsyncClient *client, void *data, size_t length) {
+        ((AuxBridge*)arg)->_onData(client, (const uint8_t*)data, length);
+    }, this);
+}
+
+void AuxBridge::_onData(AsyncClient *client, const uint8_t *data, size_t length) {
+    xSemaphoreTake(_lock, portMAX_DELAY);
+    if (client == _client) {
+        size_t room = sizeof(_request) - _requestLength;
+        size_t copied = min(length, room);
+        memcpy(_request + _requestLength, data, copied);
+        _requestLength += copied;
+        _dropped += length - copied;
+    }
+    xSemaphoreGive(_lock);
+    
+    if (_worker) {
+        xTaskNotifyGive(_worker);
+    }
+}
+
+void AuxBridge::_onDisconnect(AsyncClient *client) {
+    xSemaphoreTake(_lock, portMAX_DELAY);
+    if (client == _client) {
+        _client = nullptr;
+        _requestLength = 0;
+    }
+    xSemaphoreGive(_lock);
+
+    // AsyncTCP leaves server-side clients to the owner
+    delete client;
+}
+
+// ============================================================================
+// Bus Transactions
+// ============================================================================
+
+size_t AuxBridge::_takeFrames(uint8_t *frames, size_t size) {
+    if (!_lock) {
+        return 0;
+    }
+
+    // Everything complete goes out together; a partial frame waits for more
+    xSemaphoreTake(_lock, portMAX_DELAY);
+    size_t length = min(_frameSpan(_request, _requestLength), size);
+    if (length > 0) {
+        memcpy(frames, _request, length);
+        memmove(_request, _request + length, _requestLength - length);
+        _requestLength -= length;
+    }
+    xSemaphoreGive(_lock);
+    return length;
+}
+
+void AuxBridge::_transact(AuxPort &port, const uint8_t *frames, size_t length) {
+    // Drop stale bytes so replies line up with this request
+    port.discard();
+    port.write(frames, length);
+    _transactions++;
+
+    // Request frames still waiting for their reply (all complete: see _takeFrames)
+    const uint8_t *requests[AUX_BRIDGE_MAX_FRAMES];
+    uint8_t pending = 0;
+    bool tracked = true;
+    for (size_t i = 0; i < length; ) {
+        if (frames[i] != CelestronAux::AUX_HDR) {
+            i++;
+            continue;
+        }
+        if (pending == AUX_BRIDGE_MAX_FRAMES) {
+            tracked = false;  // Too many to match: fall back to waiting for quiet
+            break;
+        }
+        if (frames[i + 1] >= 3) {
+            requests[pending++] = frames + i;  // Has source, destination and command
+        }
+        i += frames[i + 1] + 3;
+    }
+    tracked = tracked && pending > 0;
+
+    // Hold the bus until every request is answered, or the replies go quiet;
+    // the port wakes us after each reply burst
+    uint8_t reply[AUX_BRIDGE_BUFFER_SIZE];
+    size_t replyLength = 0;
+    while (port.wait(AUX_BRIDGE_REPLY_GAP)) {
+        int byte;
+        while (replyLength < sizeof(reply) && (byte = port.read()) >= 0) {
+            reply[replyLength++] = byte;
+        }
+
+        // Forward complete frames right away rather than byte by byte
+        size_t complete = (replyLength == sizeof(reply)) ? replyLength : _frameSpan(reply, replyLength);
+        if (complete > 0) {
+            pending = _matchReplies(reply, complete, requests, pending);
+            _forward(reply, complete);
+            memmove(reply, reply + complete, replyLength - complete);
+            replyLength -= complete;
+        }
+
+        // Last reply forwarded: the bus is free for the next transaction
+        if (tracked && pending == 0 && replyLength == 0) {
+            return;
+        }
+    }
+
+    if (replyLength > 0) {
+        _forward(reply, replyLength);
+    }
+}
+
+void AuxBridge::_forward(const uint8_t *data, size_t length) {
+    xSemaphoreTake(_lock, portMAX_DELAY);
+    if (_client && _client->space() >= length) {
+        _client->add((const char*)data, length);
+        _client->send();
+    } else {
+        _dropped += length;
+    }
+    xSemaphoreGive(_lock);
+}
+
+uint8_t AuxBridge::_matchReplies(const uint8_t *data, size_t length, const uint8_t **requests, uint8_t pending) {
+    // A reply comes from the request's destination, is addressed to its
+    // source and carries the same command; a bus echo of the request is not
+    for (size_t i = 0; i + 5 <= length; ) {
+        if (data[i] != CelestronAux::AUX_HDR) {
+            i++;
+            continue;
+        }
+        for (uint8_t r = 0; r < pending; r++) {
+            const uint8_t *request = requests[r];
+            if (data[i + 2] == request[3] && data[i + 3] == request[2] && data[i + 4] == request[4]) {
+                requests[r] = requests[--pending];
+                break;
+            }
+        }
+        i += data[i + 1] + 3;
+    }
+    return pending;
+}
+
+size_t AuxBridge::_frameSpan(const uint8_t *data, size_t length) {
+    // Bytes up to the end of the last complete frame: 3B, length, payload, checksum
+    size_t span = 0;
+    while (span < length) {
+        if (data[span] != CelestronAux::AUX_HDR) {
+            // Not a frame start (line noise or a client's own framing): pass it through
+            span++;
+            continue;
+        }
+        if (span + 2 > length) {
+            break;
+        }
+        size_t frameLength = data[span + 1] + 3;
+        if (span + frameLength > length) {
+            break;
+        }
+        span += frameLength;
+    }
+    return span;
+}
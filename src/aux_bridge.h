@@ -0,0 +1,77 @@
+/*
+    AUX TCP Bridge for ESP32 Celestron Focuser Controller
+    Raw AUX frames over TCP port 2000, as served by Celestron's WiFi modules
+
+    Copyright (C) 2024
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include <AsyncTCP.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "celestron_aux.h"
+#include "aux_port.h"
+
+// Bridge Configuration
+#define AUX_BRIDGE_PORT 2000            // SkyPortal / CPWI / INDI celestron_aux
+#define AUX_BRIDGE_BUFFER_SIZE 256      // Bytes buffered in each direction
+#define AUX_BRIDGE_REPLY_GAP 100        // Bus released after this long without a reply byte (unanswered requests)
+#define AUX_BRIDGE_MAX_FRAMES 16        // Request frames matched to their replies per transaction
+#define AUX_BRIDGE_MAX_BURST 8          // Pipelined transactions per handle() call
+
+/**
+ * AUX Bridge Class
+ * Frames from one TCP client are written to the AUX bus from the AUX task, so
+ * bridge transactions and the firmware's own Communicator traffic take
+ * turns and never collide. Queued request frames go out in one write, each
+ * complete reply frame is forwarded as soon as it arrives, and the bus is
+ * released once every request has its reply.
+ */
+class AuxBridge {
+public:
+    // Constructor
+    AuxBridge();
+
+    // Initialization
+    void begin();
+    void setWorkerTask(TaskHandle_t task);
+
+    // AUX task (owns the bus while a transaction is running)
+    void handle(AuxPort &port);
+
+    // Status
+    bool isConnected();
+    uint32_t getTransactions();
+    uint32_t getDropped();
+
+private:
+    AsyncServer _server;
+    AsyncClient* _client;
+    SemaphoreHandle_t _lock;            // Guards _client and _request (TCP task vs AUX task)
+    TaskHandle_t _worker;               // Woken when request bytes arrive
+
+    // TCP -> AUX
+    uint8_t _request[AUX_BRIDGE_BUFFER_SIZE];
+    size_t _requestLength;
+
+    // Statistics
+    uint32_t _transactions;
+    uint32_t _dropped;                  // Bytes lost to a full buffer or TCP window
+
+    // TCP task callbacks
+    void _onClient(AsyncClient *client);
+    void _onData(AsyncClient *client, const uint8_t *data, size_t length);
+    void _onDisconnect(AsyncClient *client);
+
+    // Bus transactions
+    size_t _takeFrames(uint8_t *frames, size_t size);
+    void _transact(AuxPort &port, const uint8_t *frames, size_t length);
+    void _forward(const uint8_t *data, size_t length);
+    static size_t _frameSpan(const uint8_t *data, size_t length);
+    static uint8_t _matchReplies(const uint8_t *data, size_t length, const uint8_t **requests, uint8_t pending);
+};
+
+// Global AUX bridge instance
+extern AuxBridge auxBridge;
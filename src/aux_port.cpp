@@ -0,0 +1,103 @@
+/*
+    AUX Serial Port Implementation for ESP32 Celestron Focuser Controller
+
+    Copyright (C) 2024
+*/
+
+#include "aux_port.h"
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+AuxPort::AuxPort(HardwareSerial &serial) : _serial(serial) {
+    _received = nullptr;
+    _overruns = 0;
+}
+
+// ============================================================================
+// Initialization
+// ============================================================================
+
+void AuxPort::begin(unsigned long baud, int8_t rxPin, int8_t txPin) {
+    if (!_received) {
+        _received = xSemaphoreCreateBinary();
+    }
+
+    _serial.begin(baud, SERIAL_8N1, rxPin, txPin);
+
+    // Only wake up when the line goes quiet: one callback per reply burst
+    _serial.setRxTimeout(AUX_RX_TIMEOUT_SYMBOLS);
+    _serial.onReceive([this]() { _onReceive(); }, true);
+    discard();
+}
+
+void AuxPort::end() {
+    _serial.end();
+}
+
+// ============================================================================
+// Transmit
+// ============================================================================
+
+bool AuxPort::write(const uint8_t *data, size_t length) {
+    size_t written = _serial.write(data, length);
+    _serial.flush();
+    return written == length;
+}
+
+// ============================================================================
+// Receive
+// ============================================================================
+
+size_t AuxPort::available() {
+    return _ring.size();
+}
+
+int AuxPort::read() {
+    uint8_t byte;
+    if (!_ring.pop(byte)) {
+        return -1;
+    }
+    return byte;
+}
+
+void AuxPort::discard() {
+    _ring.clear();
+    if (_received) {
+        xSemaphoreTake(_received, 0);
+    }
+}
+
+bool AuxPort::wait(uint32_t timeoutMs) {
+    // A burst that lands between the check and the take still gives the
+    // semaphore; a give left over from a burst already read is skipped
+    unsigned long start = millis();
+    for (;;) {
+        if (available() > 0) {
+            return true;
+        }
+        unsigned long elapsed = millis() - start;
+        if (!_received || elapsed >= timeoutMs ||
+            xSemaphoreTake(_received, pdMS_TO_TICKS(timeoutMs - elapsed)) != pdTRUE) {
+            return available() > 0;
+        }
+    }
+}
+
+uint32_t AuxPort::getOverruns() {
+    return _overruns;
+}
+
+// ============================================================================
+// UART Event Task
+// ============================================================================
+
+void AuxPort::_onReceive() {
+    uint8_t chunk[32];
+    size_t length;
+    while ((length = _serial.read(chunk, min((size_t)_serial.available(), sizeof(chunk)))) > 0) {
+        _overruns += length - _ring.push(chunk, length);
+    }
+    xSemaphoreGive(_received);
+}
@@ -0,0 +1,56 @@
+/*
+    AUX Serial Port for ESP32 Celestron Focuser Controller
+    Event-driven UART receive with hardware idle-timeout framing
+
+    Copyright (C) 2024
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "spsc_ring.h"
+
+// Port Configuration
+#define AUX_RX_TIMEOUT_SYMBOLS 2        // Idle character times that end a burst (~1 ms at 19200 baud)
+#define AUX_RX_RING_SIZE 256            // Received bytes waiting for the parser (power of two)
+
+/**
+ * AUX Port Class
+ * The UART driver reports each burst from its event task once the line has
+ * been idle for AUX_RX_TIMEOUT_SYMBOLS; the bytes are moved into a ring and
+ * the reader is woken. Readers block on the ring instead of polling the UART.
+ * One reader (the AUX task) and one writer (the UART event task).
+ */
+class AuxPort {
+public:
+    // Constructor
+    AuxPort(HardwareSerial &serial);
+
+    // Initialization (also used to change the baud rate)
+    void begin(unsigned long baud, int8_t rxPin, int8_t txPin);
+    void end();
+
+    // Transmit (returns once the frame has left the UART)
+    bool write(const uint8_t *data, size_t length);
+
+    // Receive
+    size_t available();
+    int read();
+    void discard();
+    bool wait(uint32_t timeoutMs);     // True once bytes are waiting
+
+    // Status
+    uint32_t getOverruns();
+
+private:
+    HardwareSerial &_serial;
+    SemaphoreHandle_t _received;        // Given by the event task after each burst
+
+    SpscRing<uint8_t, AUX_RX_RING_SIZE> _ring;  // Event task -> reader
+    volatile uint32_t _overruns;        // Bytes lost to a full ring
+
+    // UART event task
+    void _onReceive();
+};
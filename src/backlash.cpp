@@ -0,0 +1,139 @@
+/*
+    Backlash Compensation Implementation for ESP32 Celestron Focuser Controller
+
+    Copyright (C) 2024
+*/
+
+#include "backlash.h"
+
+using namespace CelestronAux;
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+BacklashManager::BacklashManager(Communicator &communicator, AuxPort &port)
+    : _communicator(communicator), _port(port) {
+    _overshoot = 0;
+    _approachDirection = APPROACH_POSITIVE;
+    _measuredBacklash = 0;
+}
+
+// ============================================================================
+// Initialization
+// ============================================================================
+
+void BacklashManager::begin() {
+    _preferences.begin(BACKLASH_PREF_NAMESPACE, false);
+
+    _overshoot = _preferences.getUInt(PREF_OVERSHOOT_KEY, 0);
+    _approachDirection = _preferences.getUChar(PREF_APPROACH_KEY, APPROACH_POSITIVE);
+
+    if (_overshoot > BACKLASH_OVERSHOOT_MAX) {
+        _overshoot = BACKLASH_OVERSHOOT_MAX;
+    }
+
+    Serial.println("INFO: Backlash overshoot: " + String(_overshoot) + " steps, approach " +
+                   String(_approachDirection == APPROACH_POSITIVE ? "+" : "-"));
+}
+
+// ============================================================================
+// Firmware Backlash
+// ============================================================================
+
+bool BacklashManager::readFirmwareBacklash(uint8_t &positive, uint8_t &negative) {
+    return _readBacklashValue(Command::MC_GET_POS_BACKLASH, positive) &&
+           _readBacklashValue(Command::MC_GET_NEG_BACKLASH, negative);
+}
+
+bool BacklashManager::writeFirmwareBacklash(uint8_t positive, uint8_t negative) {
+    if (positive > BACKLASH_FIRMWARE_MAX || negative > BACKLASH_FIRMWARE_MAX) {
+        return false;
+    }
+
+    return _writeBacklashValue(Command::MC_SET_POS_BACKLASH, positive) &&
+           _writeBacklashValue(Command::MC_SET_NEG_BACKLASH, negative);
+}
+
+bool BacklashManager::_readBacklashValue(Command cmd, uint8_t &value) {
+    Buffer reply;
+    if (_communicator.sendCommand(_port, Target::FOCUSER, cmd, reply)) {
+        if (!reply.empty()) {
+            value = reply[0];
+            return true;
+        }
+    }
+    return false;
+}
+
+bool BacklashManager::_writeBacklashValue(Command cmd, uint8_t value) {
+    Buffer data = {value};
+    Buffer reply;
+
+    // MC_SET_*_BACKLASH are acknowledged with an empty reply
+    return _communicator.sendCommand(_port, Target::FOCUSER, cmd, data, reply);
+}
+
+// ============================================================================
+// Software Overshoot Configuration
+// ============================================================================
+
+void BacklashManager::setOvershoot(uint32_t steps) {
+    _overshoot = min(steps, (uint32_t)BACKLASH_OVERSHOOT_MAX);
+    _preferences.putUInt(PREF_OVERSHOOT_KEY, _overshoot);
+}
+
+uint32_t BacklashManager::getOvershoot() {
+    return _overshoot;
+}
+
+void BacklashManager::setApproachDirection(uint8_t direction) {
+    _approachDirection = (direction == APPROACH_NEGATIVE) ? APPROACH_NEGATIVE : APPROACH_POSITIVE;
+    _preferences.putUChar(PREF_APPROACH_KEY, _approachDirection);
+}
+
+uint8_t BacklashManager::getApproachDirection() {
+    return _approachDirection;
+}
+
+// ============================================================================
+// Move Planning
+// ============================================================================
+
+bool BacklashManager::planApproach(uint32_t from, uint32_t target, uint32_t &firstLeg) {
+    return planApproach(from, target, _approachDirection, firstLeg);
+}
+
+bool BacklashManager::planApproach(uint32_t from, uint32_t target, uint8_t direction, uint32_t &firstLeg) {
+    // Returns true when the move must first overshoot past target so that the
+    // final leg always arrives travelling in the approach direction
+    if (_overshoot == 0 || from == target) {
+        return false;
+    }
+
+    if (direction == APPROACH_POSITIVE) {
+        if (target > from) {
+            return false;  // Already arriving in positive direction
+        }
+        firstLeg = (target > _overshoot) ? target - _overshoot : 0;
+    } else {
+        if (target < from) {
+            return false;  // Already arriving in negative direction
+        }
+        firstLeg = min(target + _overshoot, (uint32_t)FOCUSER_POSITION_MAX);
+    }
+
+    return firstLeg != target;
+}
+
+// ============================================================================
+// Measurement Results
+// ============================================================================
+
+void BacklashManager::setMeasuredBacklash(uint32_t steps) {
+    _measuredBacklash = steps;
+}
+
+uint32_t BacklashManager::getMeasuredBacklash() {
+    return _measuredBacklash;
+}
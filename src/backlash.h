@@ -0,0 +1,77 @@
+/*
+    Backlash Compensation for ESP32 Celestron Focuser Controller
+    Firmware backlash settings and software overshoot-and-return
+
+    Copyright (C) 2024
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include "celestron_aux.h"
+
+// Preferences keys
+#define BACKLASH_PREF_NAMESPACE "focuser"
+#define PREF_OVERSHOOT_KEY "bl_overshoot"
+#define PREF_APPROACH_KEY "bl_approach"
+
+// Limits
+#define BACKLASH_FIRMWARE_MAX 99        // MC_SET_*_BACKLASH accepts 0-99
+#define BACKLASH_OVERSHOOT_MAX 5000     // Software overshoot in steps
+#define FOCUSER_POSITION_MAX 0xFFFFFF   // 24 bit AUX position
+
+// Measurement defaults
+// The AUX position comes from the motor encoder, which cannot see slack
+// between the motor and the drawtube. A measurement reverses in small steps
+// until the user reports the first visible movement of the image or drawtube.
+#define BACKLASH_MEASURE_SPAN 300       // Preload move, and the longest reversal
+#define BACKLASH_MEASURE_INCREMENT 5    // Default reversal step
+
+/**
+ * Backlash Manager Class
+ * Reads/writes the focuser's own backlash settings and plans
+ * software overshoot-and-return moves for a fixed approach direction
+ */
+class BacklashManager {
+public:
+    // Approach directions (same convention as moveFocuser: 1 = MC_MOVE_POS)
+    static const uint8_t APPROACH_NEGATIVE = 0;
+    static const uint8_t APPROACH_POSITIVE = 1;
+
+    // Constructor
+    BacklashManager(CelestronAux::Communicator &communicator, AuxPort &port);
+
+    // Initialization
+    void begin();
+
+    // Firmware Backlash (MC_GET/SET_POS/NEG_BACKLASH)
+    bool readFirmwareBacklash(uint8_t &positive, uint8_t &negative);
+    bool writeFirmwareBacklash(uint8_t positive, uint8_t negative);
+
+    // Software Overshoot Configuration
+    void setOvershoot(uint32_t steps);
+    uint32_t getOvershoot();
+    void setApproachDirection(uint8_t direction);
+    uint8_t getApproachDirection();
+
+    // Move Planning
+    bool planApproach(uint32_t from, uint32_t target, uint32_t &firstLeg);
+    bool planApproach(uint32_t from, uint32_t target, uint8_t direction, uint32_t &firstLeg);
+
+    // Measurement Results
+    void setMeasuredBacklash(uint32_t steps);
+    uint32_t getMeasuredBacklash();
+
+private:
+    CelestronAux::Communicator &_communicator;
+    AuxPort &_port;
+    Preferences _preferences;
+
+    uint32_t _overshoot;
+    uint8_t _approachDirection;
+    uint32_t _measuredBacklash;
+
+    bool _readBacklashValue(CelestronAux::Command cmd, uint8_t &value);
+    bool _writeBacklashValue(CelestronAux::Command cmd, uint8_t value);
+};
@@ -0,0 +1,66 @@
+/*
+    Binary WebSocket Protocol Implementation for ESP32 Celestron Focuser Controller
+
+    Copyright (C) 2024
+*/
+
+#include "binary_protocol.h"
+#include "command_registry.h"
+
+// ============================================================================
+// Frame Encoding
+// ============================================================================
+
+size_t BinaryProtocol::encodeStatus(uint8_t* frame, const FocuserStatus& status, uint32_t seq) {
+    frame[0] = FRAME_STATUS;
+    frame[1] = (status.connected ? STATUS_FLAG_CONNECTED : 0) | (status.moving ? STATUS_FLAG_MOVING : 0);
+    frame[2] = status.speed;
+    frame[3] = status.faultCode;
+    _putU32(frame + 4, seq);
+    _putU32(frame + 8, status.position);
+    _putU32(frame + 12, status.target);
+    return FRAME_STATUS_SIZE;
+}
+
+size_t BinaryProtocol::encodePosition(uint8_t* frame, uint32_t position, bool moving, uint32_t timeMs) {
+    frame[0] = FRAME_POSITION;
+    frame[1] = moving ? STATUS_FLAG_MOVING : 0;
+    _putU16(frame + 2, 0);
+    _putU32(frame + 4, timeMs);
+    _putU32(frame + 8, position);
+    return FRAME_POSITION_SIZE;
+}
+
+size_t BinaryProtocol::encodeAck(uint8_t* frame, uint8_t status, uint32_t commandHash, uint32_t requestId) {
+    frame[0] = FRAME_ACK;
+    frame[1] = status;
+    _putU16(frame + 2, 0);
+    _putU32(frame + 4, commandHash);
+    _putU32(frame + 8, requestId);
+    return FRAME_ACK_SIZE;
+}
+
+// ============================================================================
+// Command Hash
+// ============================================================================
+
+uint32_t BinaryProtocol::commandHash(const char* command) {
+    // Same hash the command registry dispatches on
+    return ::commandHash(command);
+}
+
+// ============================================================================
+// Private Methods
+// ============================================================================
+
+void BinaryProtocol::_putU16(uint8_t* p, uint16_t value) {
+    p[0] = value & 0xFF;
+    p[1] = (value >> 8) & 0xFF;
+}
+
+void BinaryProtocol::_putU32(uint8_t* p, uint32_t value) {
+    p[0] = value & 0xFF;
+    p[1] = (value >> 8) & 0xFF;
+    p[2] = (value >> 16) & 0xFF;
+    p[3] = (value >> 24) & 0xFF;
+}
@@ -0,0 +1,66 @@
+/*
+    Binary WebSocket Protocol for ESP32 Celestron Focuser Controller
+    Fixed-layout little-endian frames for high-rate telemetry
+
+    Copyright (C) 2024
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include "focuser_status.h"
+
+// Negotiation: client sends {"command":"hello","protocol":"binary"}
+#define BINARY_PROTOCOL_NAME    "binary"
+#define BINARY_PROTOCOL_VERSION 1
+
+// Frame types (first byte of every frame)
+#define FRAME_STATUS            0x01
+#define FRAME_POSITION          0x02
+#define FRAME_ACK               0x03
+
+// Frame sizes in bytes
+#define FRAME_STATUS_SIZE       16
+#define FRAME_POSITION_SIZE     12
+#define FRAME_ACK_SIZE          12
+
+// Status frame flags
+#define STATUS_FLAG_CONNECTED   0x01
+#define STATUS_FLAG_MOVING      0x02
+
+// Ack frame status codes
+#define ACK_SUCCESS             0
+#define ACK_ERROR               1
+#define ACK_ACCEPTED            2   // Long-running command started; a second ack follows
+
+/*
+    Frame layouts (all multi-byte fields little-endian)
+
+    Status   (16): u8 type, u8 flags, u8 speed, u8 fault,
+                   u32 seq, u32 position, u32 target
+    Position (12): u8 type, u8 flags, u16 reserved,
+                   u32 timeMs, u32 position
+    Ack      (12): u8 type, u8 status, u16 reserved,
+                   u32 commandHash, u32 requestId
+
+    Long-running commands get an ACK_ACCEPTED ack, then an ACK_SUCCESS or
+    ACK_ERROR ack with the same hash and request id when they finish.
+*/
+
+/**
+ * Binary Frame Encoder
+ * Writes frames into caller-provided buffers; no allocation
+ */
+class BinaryProtocol {
+public:
+    static size_t encodeStatus(uint8_t* frame, const FocuserStatus& status, uint32_t seq);
+    static size_t encodePosition(uint8_t* frame, uint32_t position, bool moving, uint32_t timeMs);
+    static size_t encodeAck(uint8_t* frame, uint8_t status, uint32_t commandHash, uint32_t requestId);
+
+    // 32 bit FNV-1a of the command name, as carried in ack frames
+    static uint32_t commandHash(const char* command);
+
+private:
+    static void _putU16(uint8_t* p, uint16_t value);
+    static void _putU32(uint8_t* p, uint32_t value);
+};
@@ -153,19 +153,19 @@ Communicator::Communicator(Target source) {
     this->source = source;
 }
 
-bool Communicator::sendCommand(HardwareSerial &serial, Target dest, Command cmd, Buffer data, Buffer &reply) {
+bool Communicator::sendCommand(AuxPort &port, Target dest, Command cmd, Buffer data, Buffer &reply) {
     int retryCount = 0;
     
     while (retryCount++ < RETRY_COUNT) {
         // Send packet
-        if (!sendPacket(serial, dest, cmd, data)) {
+        if (!sendPacket(port, dest, cmd, data)) {
             Serial.printf("Send failed on attempt %d\n", retryCount);
             continue;
         }
         
         // Read response
         Packet responsePacket;
-        if (!readPacket(serial, responsePacket)) {
+        if (!readPacket(port, responsePacket)) {
             Serial.printf("Read failed on attempt %d\n", retryCount);
             continue;
         }
@@ -187,48 +187,48 @@ bool Communicator::sendCommand(HardwareSerial &serial, Target dest, Command cmd,
     return false;
 }
 
-bool Communicator::sendCommand(HardwareSerial &serial, Target dest, Command cmd, Buffer &reply) {
+bool Communicator::sendCommand(AuxPort &port, Target dest, Command cmd, Buffer &reply) {
     Buffer emptyData;
-    return sendCommand(serial, dest, cmd, emptyData, reply);
+    return sendCommand(port, dest, cmd, emptyData, reply);
 }
 
-bool Communicator::commandBlind(HardwareSerial &serial, Target dest, Command cmd, Buffer data) {
+bool Communicator::commandBlind(AuxPort &port, Target dest, Command cmd, Buffer data) {
     // For blind commands, just send the packet without waiting for response
-    return sendPacket(serial, dest, cmd, data);
+    return sendPacket(port, dest, cmd, data);
 }
 
-bool Communicator::sendPacket(HardwareSerial &serial, Target dest, Command cmd, Buffer data) {
+bool Communicator::sendPacket(AuxPort &port, Target dest, Command cmd, Buffer data) {
     Packet packet(source, dest, cmd, data);
     Buffer txBuffer;
     packet.fillBuffer(txBuffer);
     
-    // Flush serial buffer
-    flushSerial(serial);
+    // Drop stale bytes so the reply lines up with this request
+    port.discard();
     
     // Send packet
-    size_t bytesWritten = serial.write(txBuffer.data(), txBuffer.size());
-    
-    if (bytesWritten != txBuffer.size()) {
-        Serial.printf("Send error: wrote %d of %d bytes\n", bytesWritten, txBuffer.size());
+    if (!port.write(txBuffer.data(), txBuffer.size())) {
+        Serial.printf("Send error: short write of %d bytes\n", txBuffer.size());
         return false;
     }
     
-    serial.flush();
     return true;
 }
 
-bool Communicator::readPacket(HardwareSerial &serial, Packet &reply) {
-    // Read all available data first
+bool Communicator::readPacket(AuxPort &port, Packet &reply) {
+    // The UART wakes us when a reply burst ends; keep reading until the
+    // length byte says the frame is complete or the reply times out
     Buffer rawData;
     uint32_t startTime = millis();
     
-    // Wait a bit for all data to arrive
-    while (millis() - startTime < 100) {  // Wait up to 100ms for complete packet
-        if (serial.available()) {
-            rawData.push_back(serial.read());
-            startTime = millis();  // Reset timer when we get data
+    while (!frameComplete(rawData)) {
+        uint32_t elapsed = millis() - startTime;
+        if (elapsed >= REPLY_TIMEOUT_MS || !port.wait(REPLY_TIMEOUT_MS - elapsed)) {
+            break;
+        }
+        int byte;
+        while ((byte = port.read()) >= 0) {
+            rawData.push_back(byte);
         }
-        delay(1);
     }
     
     if (rawData.empty()) {
@@ -280,23 +280,27 @@ bool Communicator::readPacket(HardwareSerial &serial, Packet &reply) {
     return reply.parse(packet);
 }
 
-void Communicator::flushSerial(HardwareSerial &serial) {
-    while (serial.available()) {
-        serial.read();
+bool Communicator::frameComplete(const Buffer &data) {
+    // Replies can arrive without the preamble (see readPacket)
+    if (data.empty()) {
+        return false;
     }
+    size_t offset = (data[0] == AUX_HDR) ? 1 : 0;
+    return data.size() > offset && data.size() >= offset + data[offset] + 2;
 }
 
-bool Communicator::waitForHeader(HardwareSerial &serial, uint32_t timeoutMs) {
+bool Communicator::waitForHeader(AuxPort &port, uint32_t timeoutMs) {
     uint32_t startTime = millis();
     
-    while (millis() - startTime < timeoutMs) {
-        if (serial.available()) {
-            uint8_t byte = serial.read();
-            if (byte == CelestronAux::AUX_HDR) {
-                return true;
-            }
+    for (;;) {
+        int byte = port.read();
+        if (byte == CelestronAux::AUX_HDR) {
+            return true;
+        }
+        uint32_t elapsed = millis() - startTime;
+        if (elapsed >= timeoutMs || (byte < 0 && !port.wait(timeoutMs - elapsed))) {
+            break;
         }
-        delay(1);
     }
     
     return false;
@@ -9,6 +9,7 @@
 
 #include <Arduino.h>
 #include <vector>
+#include "aux_port.h"
 
 /**
  * Celestron AUX Protocol Implementation
@@ -112,9 +113,9 @@ public:
     Communicator(Target source);
     
     // Communication methods
-    bool sendCommand(HardwareSerial &serial, Target dest, Command cmd, Buffer data, Buffer &reply);
-    bool sendCommand(HardwareSerial &serial, Target dest, Command cmd, Buffer &reply);
-    bool commandBlind(HardwareSerial &serial, Target dest, Command cmd, Buffer data);
+    bool sendCommand(AuxPort &port, Target dest, Command cmd, Buffer data, Buffer &reply);
+    bool sendCommand(AuxPort &port, Target dest, Command cmd, Buffer &reply);
+    bool commandBlind(AuxPort &port, Target dest, Command cmd, Buffer data);
     
     // Properties
     Target source;
@@ -122,15 +123,16 @@ public:
     // Configuration
     static const uint32_t TIMEOUT_MS = 2000;  // 2 second timeout
     static const uint32_t RETRY_COUNT = 3;    // Retry failed commands
+    static const uint32_t REPLY_TIMEOUT_MS = 100;  // Send to complete reply frame
     
 private:
     // Low-level communication
-    bool sendPacket(HardwareSerial &serial, Target dest, Command cmd, Buffer data);
-    bool readPacket(HardwareSerial &serial, Packet &reply);
+    bool sendPacket(AuxPort &port, Target dest, Command cmd, Buffer data);
+    bool readPacket(AuxPort &port, Packet &reply);
     
     // Utility methods
-    void flushSerial(HardwareSerial &serial);
-    bool waitForHeader(HardwareSerial &serial, uint32_t timeoutMs);
+    static bool frameComplete(const Buffer &data);
+    bool waitForHeader(AuxPort &port, uint32_t timeoutMs);
 };
 
 } // namespace CelestronAux
@@ -0,0 +1,110 @@
+/*
+    Command Registry Implementation for ESP32 Celestron Focuser Controller
+
+    Copyright (C) 2024
+*/
+
+#include "command_registry.h"
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+CommandRegistry::CommandRegistry(const CommandDef* commands, size_t count, uint32_t seed) {
+    _commands = commands;
+    _count = count;
+    _seed = seed;
+
+    // Seed was checked collision-free at compile time, so each slot holds one command
+    memset(_slots, COMMAND_EMPTY_SLOT, sizeof(_slots));
+    for (size_t i = 0; i < count; i++) {
+        _slots[commandSlot(commands[i].hash, seed)] = i;
+    }
+}
+
+// ============================================================================
+// Lookup
+// ============================================================================
+
+const CommandDef* CommandRegistry::find(const char* name) {
+    uint32_t hash = commandHash(name);
+    uint8_t index = _slots[commandSlot(hash, _seed)];
+    if (index == COMMAND_EMPTY_SLOT) {
+        return nullptr;
+    }
+
+    // Unknown names can land on a used slot: confirm it is really this command
+    const CommandDef &command = _commands[index];
+    if (command.hash != hash || strcmp(command.name, name) != 0) {
+        return nullptr;
+    }
+    return &command;
+}
+
+size_t CommandRegistry::count() {
+    return _count;
+}
+
+const CommandDef* CommandRegistry::get(size_t index) {
+    return (index < _count) ? &_commands[index] : nullptr;
+}
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+CommandResult CommandRegistry::dispatch(const char* name, const CommandContext &context, JsonDocument &args,
+                                        JsonDocument &response, const CommandDef **matched) {
+    const CommandDef *command = find(name);
+    if (matched) {
+        *matched = command;
+    }
+    if (!command) {
+        Serial.printf("ERROR: Unknown command: %s\n", name);
+        response["message"] = "unknown command";
+        return COMMAND_UNKNOWN;
+    }
+
+    if (!_validate(*command, args, response)) {
+        return COMMAND_INVALID;
+    }
+
+    return command->handler(context, args, response) ? COMMAND_OK : COMMAND_FAILED;
+}
+
+// ============================================================================
+// Private Methods
+// ============================================================================
+
+bool CommandRegistry::_validate(const CommandDef &command, JsonDocument &args, JsonDocument &response) {
+    // Handlers can read declared parameters without checking them again
+    for (uint8_t i = 0; i < COMMAND_MAX_PARAMS && command.params[i].name; i++) {
+        const CommandParam &param = command.params[i];
+        JsonVariantConst value = args[param.name];
+
+        if (value.isNull() ? param.required : !_matchesType(value, param.type)) {
+            Serial.printf("ERROR: %s: missing or invalid parameter '%s'\n", command.name, param.name);
+            response["message"] = "invalid parameter";
+            response["param"] = param.name;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CommandRegistry::_matchesType(JsonVariantConst value, ParamType type) {
+    switch (type) {
+        case PARAM_UINT8:  return value.is<uint8_t>();
+        case PARAM_UINT16: return value.is<uint16_t>();
+        case PARAM_UINT32: return value.is<uint32_t>();
+        case PARAM_INT32:  return value.is<int32_t>();
+        case PARAM_FLOAT:  return value.is<float>();
+        case PARAM_BOOL:   return value.is<bool>();
+        case PARAM_STRING: return value.is<const char*>();
+        case PARAM_OBJECT: return value.is<JsonObjectConst>();
+        case PARAM_DIRECTION:
+            return value.is<const char*>() &&
+                   (strcmp(value.as<const char*>(), "in") == 0 || strcmp(value.as<const char*>(), "out") == 0);
+    }
+    return false;
+}
@@ -0,0 +1,152 @@
+/*
+    Command Registry for ESP32 Celestron Focuser Controller
+    Perfect-hash dispatch of named JSON commands with parameter schemas
+
+    Copyright (C) 2024
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// Dispatch table (slots must outnumber commands; more slots = faster seed search)
+#define COMMAND_TABLE_BITS 7
+#define COMMAND_TABLE_SIZE (1 << COMMAND_TABLE_BITS)
+#define COMMAND_MAX_PARAMS 6
+#define COMMAND_SEED_LIMIT 256          // Seeds tried at compile time
+#define COMMAND_NO_SEED 0xFFFFFFFFUL
+#define COMMAND_EMPTY_SLOT 0xFF
+
+// Command flags
+#define CMD_FLAG_RAW 0x01               // Handler builds the whole reply (no status/command fields)
+
+// Long-running commands: WebSocket clients get an "accepted" reply, then a
+// "completed" or "failed" event once the operation finishes
+#define CMD_FLAG_MOTION 0x02            // Finishes when the move ends
+#define CMD_FLAG_CALIBRATION 0x04       // Finishes when calibration ends
+#define CMD_FLAG_BLOCKING 0x08          // Finishes when the handler returns
+#define CMD_FLAG_OPERATION (CMD_FLAG_MOTION | CMD_FLAG_CALIBRATION | CMD_FLAG_BLOCKING)
+
+/**
+ * Parameter Types
+ * Checked against the JSON value before the handler runs
+ */
+enum ParamType : uint8_t {
+    PARAM_UINT8,
+    PARAM_UINT16,
+    PARAM_UINT32,
+    PARAM_INT32,
+    PARAM_FLOAT,
+    PARAM_BOOL,
+    PARAM_STRING,
+    PARAM_OBJECT,
+    PARAM_DIRECTION             // "in" (positive) or "out" (negative)
+};
+
+/**
+ * Command Parameter
+ * A null name ends the list
+ */
+struct CommandParam {
+    const char* name;
+    ParamType type;
+    bool required;
+};
+
+/**
+ * Command Source
+ * Which front end a command arrived on
+ */
+enum CommandSource : uint8_t {
+    SOURCE_WEBSOCKET,
+    SOURCE_REST,
+    SOURCE_SERIAL
+};
+
+struct CommandContext {
+    CommandSource source;
+    uint32_t clientId;          // WebSocket client id (0 for other sources)
+};
+
+typedef bool (*CommandHandler)(const CommandContext &context, JsonDocument &args, JsonDocument &response);
+
+/**
+ * Command Definition
+ * Tables are constexpr so the perfect hash seed is found by the compiler
+ */
+struct CommandDef {
+    const char* name;
+    uint32_t hash;
+    CommandHandler handler;
+    uint8_t flags;
+    CommandParam params[COMMAND_MAX_PARAMS];
+};
+
+enum CommandResult : uint8_t {
+    COMMAND_OK,
+    COMMAND_FAILED,
+    COMMAND_UNKNOWN,
+    COMMAND_INVALID
+};
+
+// ============================================================================
+// Compile-Time Hashing
+// ============================================================================
+
+// 32 bit FNV-1a of a command name (also carried in binary ack frames)
+constexpr uint32_t commandHash(const char* name, uint32_t hash = 2166136261UL) {
+    return *name ? commandHash(name + 1, (hash ^ (uint8_t)*name) * 16777619UL) : hash;
+}
+
+// Expands to the name and hash fields of a CommandDef
+#define COMMAND_NAME(name) name, commandHash(name)
+
+constexpr uint8_t commandSlot(uint32_t hash, uint32_t seed) {
+    return (uint8_t)((uint32_t)((hash ^ seed) * 2654435761UL) >> (32 - COMMAND_TABLE_BITS));
+}
+
+constexpr bool commandSlotTaken(const CommandDef* commands, size_t count, uint32_t seed, size_t i, size_t j) {
+    return j < count && (commandSlot(commands[i].hash, seed) == commandSlot(commands[j].hash, seed) ||
+                         commandSlotTaken(commands, count, seed, i, j + 1));
+}
+
+constexpr bool commandSeedIsPerfect(const CommandDef* commands, size_t count, uint32_t seed, size_t i = 0) {
+    return i >= count || (!commandSlotTaken(commands, count, seed, i, i + 1) &&
+                          commandSeedIsPerfect(commands, count, seed, i + 1));
+}
+
+// First seed that gives every command its own slot, or COMMAND_NO_SEED
+constexpr uint32_t commandFindSeed(const CommandDef* commands, size_t count, uint32_t seed = 0) {
+    return seed >= COMMAND_SEED_LIMIT ? COMMAND_NO_SEED :
+           commandSeedIsPerfect(commands, count, seed) ? seed : commandFindSeed(commands, count, seed + 1);
+}
+
+/**
+ * Command Registry Class
+ * One table shared by the WebSocket, REST and serial front ends; lookup
+ * is a hash, one slot read and a single name compare
+ */
+class CommandRegistry {
+public:
+    // Constructor
+    CommandRegistry(const CommandDef* commands, size_t count, uint32_t seed);
+
+    // Lookup
+    const CommandDef* find(const char* name);
+    size_t count();
+    const CommandDef* get(size_t index);
+
+    // Dispatch (optionally reports the matched command, nullptr if unknown)
+    CommandResult dispatch(const char* name, const CommandContext &context, JsonDocument &args,
+                           JsonDocument &response, const CommandDef **matched = nullptr);
+
+private:
+    const CommandDef* _commands;
+    size_t _count;
+    uint32_t _seed;
+    uint8_t _slots[COMMAND_TABLE_SIZE];
+
+    bool _validate(const CommandDef &command, JsonDocument &args, JsonDocument &response);
+    static bool _matchesType(JsonVariantConst value, ParamType type);
+};
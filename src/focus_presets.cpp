@@ -0,0 +1,145 @@
+/*
+    Focus Presets Implementation for ESP32 Celestron Focuser Controller
+
+    Copyright (C) 2024
+*/
+
+#include "focus_presets.h"
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+PresetStore::PresetStore() {
+    memset(_presets, 0, sizeof(_presets));
+}
+
+// ============================================================================
+// Initialization
+// ============================================================================
+
+void PresetStore::begin() {
+    _preferences.begin(PRESET_PREF_NAMESPACE, false);
+
+    for (uint8_t slot = 0; slot < PRESET_MAX_COUNT; slot++) {
+        String key = _slotKey(slot);
+        FocusPreset &preset = _presets[slot];
+
+        if (_preferences.getBytesLength(key.c_str()) != sizeof(FocusPreset) ||
+            _preferences.getBytes(key.c_str(), &preset, sizeof(FocusPreset)) != sizeof(FocusPreset)) {
+            memset(&preset, 0, sizeof(FocusPreset));
+        }
+        preset.name[PRESET_NAME_LEN - 1] = '\0';
+    }
+
+    Serial.println("INFO: Focus presets loaded: " + String(count()));
+}
+
+// ============================================================================
+// Preset Management
+// ============================================================================
+
+bool PresetStore::save(const String& name, uint32_t position, uint8_t approach, uint8_t speed) {
+    if (!isValidName(name)) {
+        return false;
+    }
+
+    // Overwrite an existing preset of the same name, else take a free slot
+    int slot = _findSlot(name);
+    if (slot < 0) {
+        for (uint8_t i = 0; i < PRESET_MAX_COUNT; i++) {
+            if (!_presets[i].used) {
+                slot = i;
+                break;
+            }
+        }
+    }
+    if (slot < 0) {
+        return false;
+    }
+
+    FocusPreset &preset = _presets[slot];
+    memset(&preset, 0, sizeof(FocusPreset));
+    strncpy(preset.name, name.c_str(), PRESET_NAME_LEN - 1);
+    preset.position = position;
+    preset.approach = approach;
+    preset.speed = constrain(speed, 1, 9);
+    preset.used = 1;
+
+    _store(slot);
+    return true;
+}
+
+bool PresetStore::remove(const String& name) {
+    int slot = _findSlot(name);
+    if (slot < 0) {
+        return false;
+    }
+
+    memset(&_presets[slot], 0, sizeof(FocusPreset));
+    _preferences.remove(_slotKey(slot).c_str());
+    return true;
+}
+
+const FocusPreset* PresetStore::find(const String& name) {
+    int slot = _findSlot(name);
+    return (slot < 0) ? nullptr : &_presets[slot];
+}
+
+// ============================================================================
+// Enumeration
+// ============================================================================
+
+uint8_t PresetStore::count() {
+    uint8_t total = 0;
+    for (uint8_t slot = 0; slot < PRESET_MAX_COUNT; slot++) {
+        if (_presets[slot].used) total++;
+    }
+    return total;
+}
+
+const FocusPreset* PresetStore::get(uint8_t slot) {
+    if (slot >= PRESET_MAX_COUNT || !_presets[slot].used) {
+        return nullptr;
+    }
+    return &_presets[slot];
+}
+
+// ============================================================================
+// Validation
+// ============================================================================
+
+bool PresetStore::isValidName(const String& name) {
+    // Must start with a letter so "g<name>" never collides with "g<position>"
+    if (name.length() == 0 || name.length() >= PRESET_NAME_LEN || !isalpha(name[0])) {
+        return false;
+    }
+
+    for (size_t i = 0; i < name.length(); i++) {
+        if (!isalnum(name[i]) && name[i] != '-' && name[i] != '_') {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// Private Methods
+// ============================================================================
+
+int PresetStore::_findSlot(const String& name) {
+    for (uint8_t slot = 0; slot < PRESET_MAX_COUNT; slot++) {
+        if (_presets[slot].used && strcasecmp(_presets[slot].name, name.c_str()) == 0) {
+            return slot;
+        }
+    }
+    return -1;
+}
+
+void PresetStore::_store(uint8_t slot) {
+    _preferences.putBytes(_slotKey(slot).c_str(), &_presets[slot], sizeof(FocusPreset));
+}
+
+String PresetStore::_slotKey(uint8_t slot) {
+    return "p" + String(slot);
+}
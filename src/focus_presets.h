@@ -0,0 +1,64 @@
+/*
+    Focus Presets for ESP32 Celestron Focuser Controller
+    Named focus positions stored in NVS and cached in RAM
+
+    Copyright (C) 2024
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include <Preferences.h>
+
+// Preferences keys
+#define PRESET_PREF_NAMESPACE "presets"
+
+// Limits
+#define PRESET_MAX_COUNT 8
+#define PRESET_NAME_LEN 16      // Including terminator
+
+/**
+ * Focus Preset
+ * Stored as a fixed-size blob per NVS slot
+ */
+struct FocusPreset {
+    char name[PRESET_NAME_LEN];
+    uint32_t position;
+    uint8_t approach;           // BacklashManager::APPROACH_*
+    uint8_t speed;              // Goto speed 1-9
+    uint8_t used;
+};
+
+/**
+ * Preset Store Class
+ * All presets are loaded once at startup so a recall is a RAM lookup
+ * followed by a single goto
+ */
+class PresetStore {
+public:
+    // Constructor
+    PresetStore();
+
+    // Initialization
+    void begin();
+
+    // Preset Management
+    bool save(const String& name, uint32_t position, uint8_t approach, uint8_t speed);
+    bool remove(const String& name);
+    const FocusPreset* find(const String& name);
+
+    // Enumeration
+    uint8_t count();
+    const FocusPreset* get(uint8_t slot);
+
+    // Validation
+    static bool isValidName(const String& name);
+
+private:
+    Preferences _preferences;
+    FocusPreset _presets[PRESET_MAX_COUNT];
+
+    int _findSlot(const String& name);
+    void _store(uint8_t slot);
+    static String _slotKey(uint8_t slot);
+};
@@ -0,0 +1,150 @@
+/*
+    Travel Limits Implementation for ESP32 Celestron Focuser Controller
+
+    Copyright (C) 2024
+*/
+
+#include "focuser_limits.h"
+
+using namespace CelestronAux;
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+FocuserLimits::FocuserLimits(Communicator &communicator, AuxPort &port)
+    : _communicator(communicator), _port(port) {
+    _hasHardStops = false;
+    _hardMin = 0;
+    _hardMax = FOCUSER_POSITION_MAX;
+    _softMin = 0;
+    _softMax = FOCUSER_POSITION_MAX;
+}
+
+// ============================================================================
+// Initialization
+// ============================================================================
+
+void FocuserLimits::begin() {
+    _preferences.begin(LIMITS_PREF_NAMESPACE, false);
+
+    _softMin = _preferences.getUInt(PREF_LIMIT_MIN_KEY, 0);
+    _softMax = _preferences.getUInt(PREF_LIMIT_MAX_KEY, FOCUSER_POSITION_MAX);
+
+    if (_softMin >= _softMax || _softMax > FOCUSER_POSITION_MAX) {
+        _softMin = 0;
+        _softMax = FOCUSER_POSITION_MAX;
+    }
+
+    Serial.println("INFO: Soft limits: " + String(_softMin) + " - " + String(_softMax));
+}
+
+// ============================================================================
+// Hard Stops
+// ============================================================================
+
+bool FocuserLimits::readHardStops() {
+    Buffer reply;
+    if (!_communicator.sendCommand(_port, Target::FOCUSER, Command::FOC_GET_HS_POSITIONS, reply)) {
+        return false;
+    }
+
+    // Two 32 bit big-endian positions: low then high
+    if (reply.size() < 8) {
+        return false;
+    }
+    uint32_t low = ((uint32_t)reply[0] << 24) | ((uint32_t)reply[1] << 16) | ((uint32_t)reply[2] << 8) | reply[3];
+    uint32_t high = ((uint32_t)reply[4] << 24) | ((uint32_t)reply[5] << 16) | ((uint32_t)reply[6] << 8) | reply[7];
+
+    // Uncalibrated focusers report an empty range
+    if (low >= high || high > FOCUSER_POSITION_MAX) {
+        _hasHardStops = false;
+        return false;
+    }
+
+    _hasHardStops = true;
+    _hardMin = low;
+    _hardMax = high;
+
+    // Stored before this calibration: the hard stops win
+    if (_softOutsideHard()) {
+        Serial.println("INFO: Soft limits " + String(_softMin) + " - " + String(_softMax) +
+                       " are outside the hard stops, using " + String(_hardMin) + " - " + String(_hardMax));
+    }
+    return true;
+}
+
+bool FocuserLimits::hasHardStops() {
+    return _hasHardStops;
+}
+
+uint32_t FocuserLimits::getHardMin() {
+    return _hardMin;
+}
+
+uint32_t FocuserLimits::getHardMax() {
+    return _hardMax;
+}
+
+// ============================================================================
+// Soft Limits
+// ============================================================================
+
+bool FocuserLimits::setSoftLimits(uint32_t minimum, uint32_t maximum) {
+    if (minimum >= maximum || maximum > FOCUSER_POSITION_MAX) {
+        return false;
+    }
+    // Must leave some travel between the hard stops
+    if (_hasHardStops && (maximum < _hardMin || minimum > _hardMax)) {
+        return false;
+    }
+
+    _softMin = minimum;
+    _softMax = maximum;
+    _preferences.putUInt(PREF_LIMIT_MIN_KEY, _softMin);
+    _preferences.putUInt(PREF_LIMIT_MAX_KEY, _softMax);
+    return true;
+}
+
+void FocuserLimits::clearSoftLimits() {
+    setSoftLimits(0, FOCUSER_POSITION_MAX);
+}
+
+uint32_t FocuserLimits::getSoftMin() {
+    return _softMin;
+}
+
+uint32_t FocuserLimits::getSoftMax() {
+    return _softMax;
+}
+
+// ============================================================================
+// Effective Range
+// ============================================================================
+
+uint32_t FocuserLimits::getMin() {
+    if (!_hasHardStops) {
+        return _softMin;
+    }
+    return _softOutsideHard() ? _hardMin : max(_softMin, _hardMin);
+}
+
+uint32_t FocuserLimits::getMax() {
+    if (!_hasHardStops) {
+        return _softMax;
+    }
+    return _softOutsideHard() ? _hardMax : min(_softMax, _hardMax);
+}
+
+uint32_t FocuserLimits::clamp(uint32_t position) {
+    return constrain(position, getMin(), getMax());
+}
+
+bool FocuserLimits::contains(uint32_t position) {
+    return position >= getMin() && position <= getMax();
+}
+
+bool FocuserLimits::_softOutsideHard() {
+    // Disjoint ranges would put getMin() above getMax()
+    return _hasHardStops && (_softMax < _hardMin || _softMin > _hardMax);
+}
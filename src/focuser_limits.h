@@ -0,0 +1,64 @@
+/*
+    Travel Limits for ESP32 Celestron Focuser Controller
+    Hard stops reported by the focuser plus user soft limits
+
+    Copyright (C) 2024
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include "celestron_aux.h"
+#include "backlash.h"
+
+// Preferences keys
+#define LIMITS_PREF_NAMESPACE "focuser"
+#define PREF_LIMIT_MIN_KEY "lim_min"
+#define PREF_LIMIT_MAX_KEY "lim_max"
+
+/**
+ * Focuser Limits Class
+ * Reads the calibrated hard stops (FOC_GET_HS_POSITIONS) and keeps
+ * persistent soft limits; gotos are clamped to the tighter of the two.
+ * Soft limits that miss the hard range entirely are ignored.
+ */
+class FocuserLimits {
+public:
+    // Constructor
+    FocuserLimits(CelestronAux::Communicator &communicator, AuxPort &port);
+
+    // Initialization
+    void begin();
+
+    // Hard Stops (FOC_GET_HS_POSITIONS)
+    bool readHardStops();
+    bool hasHardStops();
+    uint32_t getHardMin();
+    uint32_t getHardMax();
+
+    // Soft Limits
+    bool setSoftLimits(uint32_t minimum, uint32_t maximum);
+    void clearSoftLimits();
+    uint32_t getSoftMin();
+    uint32_t getSoftMax();
+
+    // Effective Range
+    uint32_t getMin();
+    uint32_t getMax();
+    uint32_t clamp(uint32_t position);
+    bool contains(uint32_t position);
+
+private:
+    CelestronAux::Communicator &_communicator;
+    AuxPort &_port;
+    Preferences _preferences;
+
+    bool _hasHardStops;
+    uint32_t _hardMin;
+    uint32_t _hardMax;
+    uint32_t _softMin;
+    uint32_t _softMax;
+
+    bool _softOutsideHard();
+};
@@ -0,0 +1,50 @@
+/*
+    Focuser Status for ESP32 Celestron Focuser Controller
+    Focuser state and the snapshot pushed to web clients
+
+    Copyright (C) 2024
+*/
+
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * Focuser State
+ * Working copy owned by the AUX task; other tasks read the copy it
+ * publishes through a Seqlock
+ */
+struct FocuserState {
+    uint32_t position;          // Last MC_GET_POSITION reply
+    uint32_t target;
+    uint8_t speed;              // 1-9
+    bool moving;
+    bool connected;
+};
+
+/**
+ * Focuser Status
+ * Plain value type so the last pushed status can be kept and compared
+ */
+struct FocuserStatus {
+    bool connected;
+    uint32_t position;
+    uint32_t target;
+    uint8_t speed;
+    bool moving;
+    uint8_t faultCode;          // MotionFault value
+    const char* fault;          // Static string from MotionWatchdog::faultName
+
+    bool operator==(const FocuserStatus& other) const {
+        return connected == other.connected &&
+               position == other.position &&
+               target == other.target &&
+               speed == other.speed &&
+               moving == other.moving &&
+               faultCode == other.faultCode;
+    }
+
+    bool operator!=(const FocuserStatus& other) const {
+        return !(*this == other);
+    }
+};
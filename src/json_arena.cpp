@@ -0,0 +1,138 @@
+/*
+    JSON Arena Allocator Implementation for ESP32 Celestron Focuser Controller
+
+    Copyright (C) 2024
+*/
+
+#include "json_arena.h"
+
+// Each block is preceded by its (aligned) size so reallocate can copy
+#define BLOCK_HEADER_SIZE JSON_ARENA_ALIGN
+
+static uint8_t auxArenaBuffer[JSON_ARENA_AUX_SIZE] __attribute__((aligned(JSON_ARENA_ALIGN)));
+static uint8_t tcpArenaBuffer[JSON_ARENA_TCP_SIZE] __attribute__((aligned(JSON_ARENA_ALIGN)));
+
+ArenaAllocator auxJsonArena(auxArenaBuffer, sizeof(auxArenaBuffer));
+ArenaAllocator tcpJsonArena(tcpArenaBuffer, sizeof(tcpArenaBuffer));
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+ArenaAllocator::ArenaAllocator(uint8_t *buffer, size_t capacity) {
+    _buffer = buffer;
+    _capacity = capacity;
+    _top = 0;
+    _peak = 0;
+    _live = 0;
+    _fallbacks = 0;
+}
+
+// ============================================================================
+// ArduinoJson::Allocator
+// ============================================================================
+
+void* ArenaAllocator::allocate(size_t size) {
+    size_t blockSize = _align(size);
+
+    if (_top + BLOCK_HEADER_SIZE + blockSize > _capacity) {
+        _fallbacks++;
+        return malloc(size);
+    }
+
+    void *pointer = _buffer + _top + BLOCK_HEADER_SIZE;
+    _blockSize(pointer) = blockSize;
+    _top += BLOCK_HEADER_SIZE + blockSize;
+    _live++;
+
+    if (_top > _peak) {
+        _peak = _top;
+    }
+    return pointer;
+}
+
+void ArenaAllocator::deallocate(void *pointer) {
+    if (!pointer) {
+        return;
+    }
+    if (!_owns(pointer)) {
+        free(pointer);
+        return;
+    }
+
+    // Give back the most recent block straight away, everything on empty
+    size_t end = (uint8_t*)pointer - _buffer + _blockSize(pointer);
+    if (end == _top) {
+        _top -= BLOCK_HEADER_SIZE + _blockSize(pointer);
+    }
+    if (--_live == 0) {
+        _top = 0;
+    }
+}
+
+void* ArenaAllocator::reallocate(void *pointer, size_t newSize) {
+    if (!pointer) {
+        return allocate(newSize);
+    }
+    if (!_owns(pointer)) {
+        return realloc(pointer, newSize);
+    }
+
+    size_t &blockSize = _blockSize(pointer);
+    size_t newBlockSize = _align(newSize);
+    size_t start = (uint8_t*)pointer - _buffer;
+
+    // Last block grows or shrinks in place
+    if (start + blockSize == _top && start + newBlockSize <= _capacity) {
+        blockSize = newBlockSize;
+        _top = start + newBlockSize;
+        if (_top > _peak) {
+            _peak = _top;
+        }
+        return pointer;
+    }
+
+    // Shrinking elsewhere keeps the block; the slack returns on rewind
+    if (newBlockSize <= blockSize) {
+        return pointer;
+    }
+
+    void *moved = allocate(newSize);
+    if (moved) {
+        memcpy(moved, pointer, blockSize);
+        deallocate(pointer);
+    }
+    return moved;
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+size_t ArenaAllocator::getCapacity() {
+    return _capacity;
+}
+
+size_t ArenaAllocator::getPeak() {
+    return _peak;
+}
+
+uint32_t ArenaAllocator::getFallbacks() {
+    return _fallbacks;
+}
+
+// ============================================================================
+// Private Methods
+// ============================================================================
+
+bool ArenaAllocator::_owns(void *pointer) {
+    return (uint8_t*)pointer >= _buffer && (uint8_t*)pointer < _buffer + _capacity;
+}
+
+size_t &ArenaAllocator::_blockSize(void *pointer) {
+    return *(size_t*)((uint8_t*)pointer - BLOCK_HEADER_SIZE);
+}
+
+size_t ArenaAllocator::_align(size_t size) {
+    return (size + JSON_ARENA_ALIGN - 1) & ~(size_t)(JSON_ARENA_ALIGN - 1);
+}
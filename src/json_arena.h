@@ -0,0 +1,55 @@
+/*
+    JSON Arena Allocator for ESP32 Celestron Focuser Controller
+    Fixed static memory for short-lived ArduinoJson documents
+
+    Copyright (C) 2024
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// Arena sizes (bytes)
+#define JSON_ARENA_AUX_SIZE 4096        // Command/response documents on the AUX task
+#define JSON_ARENA_TCP_SIZE 2048        // REST request parsing on the TCP task
+#define JSON_ARENA_ALIGN 8
+
+/**
+ * Arena Allocator Class
+ * Bump allocator over a static buffer that rewinds once every block has
+ * been released, so request/response documents built and dropped per
+ * message never touch the heap. Falls back to malloc when full.
+ * Not thread-safe: use one arena per task.
+ */
+class ArenaAllocator : public ArduinoJson::Allocator {
+public:
+    // Constructor
+    ArenaAllocator(uint8_t *buffer, size_t capacity);
+
+    // ArduinoJson::Allocator
+    void* allocate(size_t size) override;
+    void deallocate(void *pointer) override;
+    void* reallocate(void *pointer, size_t newSize) override;
+
+    // Statistics
+    size_t getCapacity();
+    size_t getPeak();
+    uint32_t getFallbacks();
+
+private:
+    uint8_t *_buffer;
+    size_t _capacity;
+    size_t _top;                // Bump offset
+    size_t _peak;
+    uint16_t _live;             // Blocks currently allocated in the arena
+    uint32_t _fallbacks;        // Allocations that went to the heap
+
+    bool _owns(void *pointer);
+    size_t &_blockSize(void *pointer);
+    static size_t _align(size_t size);
+};
+
+// One arena per task that builds documents
+extern ArenaAllocator auxJsonArena;
+extern ArenaAllocator tcpJsonArena;
@@ -12,6 +12,18 @@
 #include <Arduino.h>
 #include "celestron_aux.h"
 #include "wifi_manager.h"
+#include "backlash.h"
+#include "motion_watchdog.h"
+#include "position_tracker.h"
+#include "temp_compensation.h"
+#include "focus_presets.h"
+#include "focuser_limits.h"
+#include "command_registry.h"
+#include "alpaca_server.h"
+#include "aux_bridge.h"
+#include "spsc_ring.h"
+#include "seqlock.h"
+#include "scheduler.h"
 
 using namespace CelestronAux;
 
@@ -28,8 +40,34 @@ using namespace CelestronAux;
 #define AUX_TX_PIN       17  // GPIO17 (TX2)
 
 // Command Configuration
-#define MAX_COMMAND_LEN  32
+#define MAX_COMMAND_LEN  128  // Room for JSON command lines
 #define POSITION_TIMEOUT 5000  // 5 seconds for position queries
+#define POSITION_CACHE_TIME 1000  // getPosition reuses a reading this recent
+
+// Goto Configuration
+#define GOTO_FAST_SPEED     9  // Speed reported for MC_GOTO_FAST moves
+#define GOTO_SLOW_MAX_SPEED 4  // Gotos at this speed or below use MC_GOTO_SLOW
+
+// Motion Watchdog Configuration
+#define WATCHDOG_SAMPLE_DIVIDER 2  // Position sample every 2nd status check
+
+// Calibration Configuration
+#define CALIBRATION_POLL_INTERVAL 1000  // FOC_CALIB_DONE query period
+#define CALIBRATION_TIMEOUT 600000      // Give up after 10 minutes
+
+// AUX Task Configuration: the task owns auxPort and the focuser state;
+// the network stack runs on core 0 (see platformio.ini)
+#define AUX_TASK_CORE        1
+#define AUX_TASK_PRIORITY    2     // Above loop() (1)
+#define AUX_TASK_STACK       8192
+#define AUX_TASK_PERIOD      10    // Longest sleep between status polls (ms)
+#define LOOP_IDLE_PERIOD     100   // Longest loop() sleep with nothing scheduled (ms)
+#define SERIAL_QUEUE_LENGTH  4     // Serial command lines waiting for the AUX task (power of two)
+
+// Web Status Configuration (only changed fields are sent)
+#define STATUS_INTERVAL_IDLE   1000  // Status push period when stopped
+#define STATUS_INTERVAL_MOVING 100   // Status push period while moving
+#define POSITION_SAMPLE_INTERVAL 20  // Binary position telemetry while moving (50 Hz)
 
 // ============================================================================
 // Global Variables
@@ -37,26 +75,60 @@ using namespace CelestronAux;
 
 // Serial Communication
 HardwareSerial auxSerial(2);  // Serial2
+AuxPort auxPort(auxSerial);
 CelestronAux::Communicator communicator;
+BacklashManager backlash(communicator, auxPort);
+MotionWatchdog watchdog;
+PositionTracker tracker;
+TempCompensator tempComp;
+PresetStore presets;
+FocuserLimits limits(communicator, auxPort);
+
+// Focuser State (written by the AUX task; other tasks read publishedState)
+FocuserState focuser = {0, 0, 5, false, false};  // Default speed 5 (1-9)
+Seqlock<FocuserState> publishedState;
+bool finalLegPending = false;  // Software backlash: final approach still to run
+uint8_t gotoSpeed = GOTO_FAST_SPEED;  // Speed of the goto in flight
+MotionFault focuserFault = FAULT_NONE;
+unsigned long lastPositionRead = 0;  // millis() of the last MC_GET_POSITION reply
 
-// Focuser State
-uint32_t currentPosition = 0;
-uint32_t targetPosition = 0;
-uint8_t currentSpeed = 5;  // Default speed (1-9)
-bool isMoving = false;
-bool focuserConnected = false;
+// Calibration (FOC_CALIB_ENABLE / FOC_CALIB_DONE)
+bool calibrating = false;
+unsigned long calibrationStart = 0;
+unsigned long lastCalibrationCheck = 0;
+
+// Backlash measurement (preload, then reversal steps until the user sees movement)
+bool measuringBacklash = false;
+bool measureReversing = false;      // Preload done, waiting for steps or confirmation
+uint32_t measureAnchor = 0;         // Position the reversal started from
+uint32_t measureReversed = 0;       // Reversal steps commanded so far
+uint8_t savedPositiveBacklash = 0;  // Firmware backlash restored afterwards
+uint8_t savedNegativeBacklash = 0;
 
 // Status checking timing
 unsigned long lastStatusCheck = 0;
+uint32_t statusCheckCount = 0;
 const unsigned long STATUS_CHECK_INTERVAL = 500;   // Check every 0.5 seconds
 
-// Command Buffer
+// Command Buffer (loop() only)
 String commandBuffer = "";
 bool commandReady = false;
 
+// AUX Task and its serial command queue
+struct SerialLine {
+    char text[MAX_COMMAND_LEN];
+};
+TaskHandle_t auxTask = nullptr;
+TaskHandle_t loopTask = nullptr;
+Scheduler loopScheduler;  // Continuations run by loop() instead of delay()
+SpscRing<SerialLine, SERIAL_QUEUE_LENGTH> serialLines;  // loop() -> AUX task
+
 // WiFi Status
 bool wifiInitialized = false;
 
+// Commands shared by WebSocket, REST and serial JSON lines (table at end of file)
+extern CommandRegistry commandRegistry;
+
 // ============================================================================
 // Function Declarations
 // ============================================================================
@@ -65,29 +137,62 @@ void setupSerial();
 void setupPins();
 bool initializeFocuser();
 void initializeWiFi();
+void auxTaskMain(void *parameter);
+void runFocuser();
+void publishState();
+void readSerialInput();
 void processCommands();
 void handleCommand(char command);
 void handleGotoCommand(String value);
+void handleBacklashCommand(String value);
+void handleTempCompCommand(String value);
+void handlePresetCommand(String value);
+void handleLimitsCommand(String value);
 void displayHelp();
 void displayStatus();
-bool handleWebFocuserCommand(String command, JsonDocument& doc);
+void handleJsonCommand(const String& line);
 
 // Focuser Control Functions
 bool getFocuserPosition();
 bool moveFocuser(uint8_t direction, uint8_t speed);
+bool startMove(uint8_t direction, uint8_t speed);
 bool stepFocuser(uint8_t direction, uint32_t steps, uint8_t speed);
-bool gotoPosition(uint32_t position);
-bool stopFocuser();
+bool gotoPosition(uint32_t position, uint8_t speed = GOTO_FAST_SPEED);
+bool startGoto(uint32_t position);
+bool startGoto(uint32_t position, uint8_t approach, uint8_t speed);
+uint8_t gotoRate(uint8_t speed);
+uint32_t trackedPosition();
+bool stopFocuser(const char* reason = "stopped");
 bool setSpeed(uint8_t speed);
 bool checkFocuserStatus();
+void handleMotionFault(MotionFault fault);
+bool motionAllowed();
+void clearMotionFault();
+void broadcastFocuserStatus();
+void finishMotion(bool success, const char* message);
+bool startCalibration();
+void checkCalibration();
+void abortCalibration(const char* reason);
+bool startBacklashMeasurement();
+void checkBacklashMeasurement();
+bool stepBacklashMeasurement(uint32_t steps);
+bool confirmBacklashMeasurement(uint32_t &steps);
+void endBacklashMeasurement(bool success, const char* reason);
+bool applyTempCorrection(int32_t steps);
+bool recallPreset(const String& name);
 
 // Utility Functions
 void printError(String message);
 void printSuccess(String message);
 void printInfo(String message);
 uint32_t parsePosition(String value);
+bool parseNumber(const String& value, float &number);
 void runDiagnostics();
 void testBaudRates();
+void showBacklash();
+void showTempComp();
+void listPresets();
+void showLimits();
 
 // ============================================================================
 // Setup Function
@@ -101,7 +206,7 @@ void setup() {
     setupPins();
     
     // Initialize AUX serial communication
-    auxSerial.begin(AUX_BAUD_RATE, SERIAL_8N1, AUX_RX_PIN, AUX_TX_PIN);
+    auxPort.begin(AUX_BAUD_RATE, AUX_RX_PIN, AUX_TX_PIN);
     
     // Wait for serial to be ready
     delay(1000);
@@ -115,6 +220,12 @@ void setup() {
     printInfo("AUX Pins: RX=" + String(AUX_RX_PIN) + ", TX=" + String(AUX_TX_PIN));
     printInfo("");
     
+    // Load backlash and temperature compensation configuration
+    backlash.begin();
+    tempComp.begin();
+    presets.begin();
+    limits.begin();
+    
     // Initialize WiFi
     initializeWiFi();
     
@@ -124,18 +235,24 @@ void setup() {
     // Try to initialize focuser with timeout
     if (initializeFocuser()) {
         printSuccess("Focuser initialized successfully");
-        focuserConnected = true;
+        focuser.connected = true;
         displayStatus();
     } else {
         printError("Failed to initialize focuser");
         printError("Check wiring and power connections");
         printInfo("Focuser will remain disconnected");
         printInfo("You can still test basic functionality");
-        focuserConnected = false;
+        focuser.connected = false;
     }
     
     printInfo("");
     displayHelp();
+    
+    // From here on only the AUX task touches the focuser
+    publishState();
+    xTaskCreatePinnedToCore(auxTaskMain, "aux", AUX_TASK_STACK, nullptr, AUX_TASK_PRIORITY, &auxTask, AUX_TASK_CORE);
+    wifiManager.setWorkerTask(auxTask);
+    auxBridge.setWorkerTask(auxTask);
 }
 
 // ============================================================================
@@ -143,44 +260,73 @@ void setup() {
 // ============================================================================
 
 void loop() {
-    // Handle WiFi operations
+    // Network housekeeping, serial input and scheduled continuations only:
+    // focuser work runs on the AUX task, which is woken as soon as a command is queued
     if (wifiInitialized) {
         wifiManager.handle();
+    }
+    readSerialInput();
+    loopScheduler.run();
+    
+    // Sleep until serial input arrives or the next continuation is due
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(loopScheduler.idleTime(LOOP_IDLE_PERIOD)));
+}
+
+// ============================================================================
+// AUX Task
+// ============================================================================
+
+void auxTaskMain(void *parameter) {
+    for (;;) {
+        // Sleep until a front end queues work or the next poll is due
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(AUX_TASK_PERIOD));
+        runFocuser();
+    }
+}
+
+void runFocuser() {
+    // Everything that touches auxPort happens here, one transaction at a time
+    if (wifiInitialized) {
+        // Web commands queued by the TCP task, then replies to the clients
+        wifiManager.processEvents();
         
-        // Send periodic status updates to web clients
+        // Raw AUX clients on TCP port 2000 take the bus between our own commands
+        auxBridge.handle(auxPort);
+        
+        // Send periodic status updates to web clients, faster while moving
         static unsigned long lastWebStatusUpdate = 0;
-        if (millis() - lastWebStatusUpdate > 1000) { // Every second
-            if (focuserConnected) {
-                // Send status to all connected web clients
-                for (int i = 0; i < 8; i++) {
-                    wifiManager.sendFocuserStatus(i, focuserConnected, currentPosition, targetPosition, currentSpeed, isMoving);
-                }
+        unsigned long statusInterval = focuser.moving ? STATUS_INTERVAL_MOVING : STATUS_INTERVAL_IDLE;
+        if (millis() - lastWebStatusUpdate > statusInterval) {
+            if (focuser.connected) {
+                broadcastFocuserStatus();
             }
             lastWebStatusUpdate = millis();
         }
+        
+        // Stream dead-reckoned position to telemetry subscribers
+        static unsigned long lastPositionSample = 0;
+        if (focuser.moving && wifiManager.hasTelemetryClients() && millis() - lastPositionSample >= POSITION_SAMPLE_INTERVAL) {
+            wifiManager.broadcastPositionSample(trackedPosition(), focuser.moving);
+            lastPositionSample = millis();
+        }
     }
     
     // Automatic focuser reconnection detection
     static unsigned long lastFocuserCheck = 0;
-    if (!focuserConnected && millis() - lastFocuserCheck > 5000) { // Check every 5 seconds if not connected
+    if (!focuser.connected && millis() - lastFocuserCheck > 5000) { // Check every 5 seconds if not connected
         if (initializeFocuser()) {
-            focuserConnected = true;
+            focuser.connected = true;
             printSuccess("Focuser automatically reconnected!");
-            // Send status update to all connected web clients
-            if (wifiInitialized) {
-                for (int i = 0; i < 8; i++) {
-                    wifiManager.sendFocuserStatus(i, focuserConnected, currentPosition, targetPosition, currentSpeed, isMoving);
-                }
-            }
+            broadcastFocuserStatus();
         }
         lastFocuserCheck = millis();
     }
     
-    // Process incoming commands
+    // Process queued serial commands
     processCommands();
     
     // Update focuser status if connected and moving (with rate limiting)
-    if (focuserConnected && isMoving) {
+    if (focuser.connected && focuser.moving) {
         unsigned long currentTime = millis();
         if (currentTime - lastStatusCheck >= STATUS_CHECK_INTERVAL) {
             checkFocuserStatus();
@@ -188,8 +334,32 @@ void loop() {
         }
     }
     
-    // Small delay to prevent overwhelming the system
-    delay(10);
+    // Calibration runs on the focuser itself; poll until it reports done
+    if (focuser.connected && calibrating && millis() - lastCalibrationCheck >= CALIBRATION_POLL_INTERVAL) {
+        checkCalibration();
+        lastCalibrationCheck = millis();
+    }
+    
+    // Backlash measurement starts reversing once the preload has landed
+    if (focuser.connected && measuringBacklash && !focuser.moving) {
+        checkBacklashMeasurement();
+    }
+    
+    // Temperature compensation: sample local sensor, correct focus when idle
+    tempComp.pollSensor(millis());
+    if (focuser.connected && !focuser.moving && !calibrating && !measuringBacklash && focuserFault == FAULT_NONE) {
+        int32_t correction;
+        if (tempComp.update(millis(), correction)) {
+            applyTempCorrection(correction);
+        }
+    }
+    
+    // Every command in this pass has finished: hand out a consistent copy
+    publishState();
+}
+
+void publishState() {
+    publishedState.write(focuser);
 }
 
 // ============================================================================
@@ -198,6 +368,10 @@ void loop() {
 
 void setupSerial() {
     Serial.begin(USB_BAUD_RATE);
+    
+    // Wake loop() as soon as command bytes arrive
+    loopTask = xTaskGetCurrentTaskHandle();
+    Serial.onReceive([]() { xTaskNotifyGive(loopTask); });
     // Don't wait for Serial on ESP32 - it may not be available immediately
     delay(1000);  // Give time for serial to initialize
 }
@@ -225,19 +399,25 @@ void initializeWiFi() {
         printInfo("WiFi disconnected, switching to AP mode");
     });
     
-    // Set up focuser control callback
-    wifiManager.setFocuserCallback([](String command, JsonDocument& doc) -> bool {
-        return handleWebFocuserCommand(command, doc);
-    });
+    // Web commands dispatch through the shared command table
+    wifiManager.setCommandRegistry(&commandRegistry);
+    
+    // Connection polling and mode switches run as loop() continuations
+    wifiManager.setScheduler(&loopScheduler);
     
     // Initialize WiFi manager
     if (wifiManager.begin()) {
         wifiInitialized = true;
         printSuccess("WiFi Manager initialized");
         
-        if (wifiManager.isConnected()) {
-            printInfo("Connected to WiFi network");
-            printInfo("Web interface: http://" + wifiManager.getIPAddress());
+        // ASCOM Alpaca clients share the web server and command table
+        alpaca.setConnectedCallback([]() { return publishedState.read().connected; });
+        alpaca.begin(wifiManager);
+        auxBridge.begin();
+        
+        if (!wifiManager.isAPMode()) {
+            // Station connection completes from loop(); onWiFiConnected reports it
+            printInfo("Connecting to WiFi network: " + wifiManager.getSSID());
         } else {
             printInfo("WiFi AP mode active");
             printInfo("Connect to: " + String(WIFI_AP_SSID));
@@ -254,7 +434,8 @@ void initializeWiFi() {
 // Command Processing
 // ============================================================================
 
-void processCommands() {
+void readSerialInput() {
+    // Runs in loop(): complete lines are handed to the AUX task
     while (Serial.available()) {
         char c = Serial.read();
         
@@ -271,16 +452,14 @@ void processCommands() {
             }
         }
         
-        // Process command if ready
         if (commandReady) {
-            if (commandBuffer.length() == 1) {
-                // Single character command
-                handleCommand(commandBuffer[0]);
-            } else if (commandBuffer.startsWith("g")) {
-                // Goto command with position
-                handleGotoCommand(commandBuffer.substring(1));
-            } else {
-                printError("Unknown command: " + commandBuffer);
+            SerialLine line;
+            memset(&line, 0, sizeof(SerialLine));
+            strncpy(line.text, commandBuffer.c_str(), MAX_COMMAND_LEN - 1);
+            if (!serialLines.push(line)) {
+                printError("Command queue full, ignored: " + commandBuffer);
+            } else if (auxTask) {
+                xTaskNotifyGive(auxTask);
             }
             
             commandBuffer = "";
@@ -289,17 +468,49 @@ void processCommands() {
     }
 }
 
+void processCommands() {
+    // Runs on the AUX task
+    SerialLine line;
+    while (serialLines.pop(line)) {
+        String command = line.text;
+        if (command.startsWith("{")) {
+            // JSON command, same format as WebSocket messages
+            handleJsonCommand(command);
+        } else if (command.length() == 1) {
+            // Single character command
+            handleCommand(command[0]);
+        } else if (command.startsWith("g")) {
+            // Goto command with position
+            handleGotoCommand(command.substring(1));
+        } else if (command.startsWith("b")) {
+            // Backlash configuration command
+            handleBacklashCommand(command.substring(1));
+        } else if (command.startsWith("tc")) {
+            // Temperature compensation command
+            handleTempCompCommand(command.substring(2));
+        } else if (command.startsWith("p")) {
+            // Focus preset command
+            handlePresetCommand(command.substring(1));
+        } else if (command.startsWith("l")) {
+            // Travel limits command
+            handleLimitsCommand(command.substring(1));
+        } else {
+            printError("Unknown command: " + command);
+        }
+    }
+}
+
 void handleCommand(char command) {
     // Handle commands that don't require focuser connection first
     switch (command) {
         case 'c':
             printInfo("Attempting to connect to focuser...");
             if (initializeFocuser()) {
-                focuserConnected = true;
+                focuser.connected = true;
                 printSuccess("Focuser connected successfully");
                 displayStatus();
             } else {
-                focuserConnected = false;
+                focuser.connected = false;
                 printError("Failed to connect to focuser");
             }
             return;
@@ -340,7 +551,7 @@ void handleCommand(char command) {
     }
     
     // For all other commands, check if focuser is connected
-    if (!focuserConnected) {
+    if (!focuser.connected) {
         printError("Focuser not connected");
         printInfo("Use 'c' command to try connecting");
         return;
@@ -349,31 +560,41 @@ void handleCommand(char command) {
     // Handle focuser-specific commands
     switch (command) {
         case '+':
-            printInfo("Moving focuser INWARD at speed " + String(currentSpeed));
-            if (moveFocuser(1, currentSpeed)) {
-                isMoving = true;
-            }
+            if (!motionAllowed()) break;
+            printInfo("Moving focuser INWARD at speed " + String(focuser.speed));
+            startMove(1, focuser.speed);
             break;
             
         case '-':
-            printInfo("Moving focuser OUTWARD at speed " + String(currentSpeed));
-            if (moveFocuser(0, currentSpeed)) {
-                isMoving = true;
-            }
+            if (!motionAllowed()) break;
+            printInfo("Moving focuser OUTWARD at speed " + String(focuser.speed));
+            startMove(0, focuser.speed);
             break;
             
         case 's':
         case '0':
             printInfo("Stopping focuser");
             if (stopFocuser()) {
-                isMoving = false;
+                focuser.moving = false;
             }
             break;
             
+        case 'b':
+            showBacklash();
+            break;
+            
+        case 'f':
+            clearMotionFault();
+            break;
+            
+        case 'l':
+            showLimits();
+            break;
+            
         case 'p':
             printInfo("Getting current position...");
             if (getFocuserPosition()) {
-                printInfo("Current position: " + String(currentPosition));
+                printInfo("Current position: " + String(focuser.position));
             }
             break;
             
@@ -389,7 +610,7 @@ void handleCommand(char command) {
             {
                 uint8_t speed = command - '0';
                 if (setSpeed(speed)) {
-                    currentSpeed = speed;
+                    focuser.speed = speed;
                     printSuccess("Speed set to " + String(speed));
                 }
             }
@@ -403,21 +624,279 @@ void handleCommand(char command) {
 }
 
 void handleGotoCommand(String value) {
-    if (!focuserConnected) {
+    if (!focuser.connected) {
         printError("Focuser not connected");
         return;
     }
     
+    // g<name> recalls a preset (names always start with a letter)
+    value.trim();
+    if (value.length() > 0 && isalpha(value[0])) {
+        recallPreset(value);
+        return;
+    }
+    
     uint32_t position = parsePosition(value);
     if (position == 0 && value != "0") {
         printError("Invalid position: " + value);
         return;
     }
     
+    if (!motionAllowed()) {
+        return;
+    }
+    
     printInfo("Moving to position " + String(position));
-    if (gotoPosition(position)) {
-        targetPosition = position;
-        isMoving = true;
+    if (startGoto(position)) {
+        tempComp.rebase();
+    }
+}
+
+void handlePresetCommand(String value) {
+    if (value.length() == 0) {
+        printError("Unknown command: p" + value);
+        return;
+    }
+    
+    char option = value[0];
+    String name = value.substring(1);
+    name.trim();
+    
+    switch (option) {
+        case 's':
+            if (!focuser.connected) {
+                printError("Focuser not connected");
+                return;
+            }
+            if (presets.save(name, trackedPosition(), backlash.getApproachDirection(), focuser.speed)) {
+                printSuccess("Preset '" + name + "' saved at position " + String(trackedPosition()));
+            } else if (!PresetStore::isValidName(name)) {
+                printError("Invalid preset name (letter first, max " + String(PRESET_NAME_LEN - 1) + " chars): " + name);
+            } else {
+                printError("No free preset slots (max " + String(PRESET_MAX_COUNT) + ")");
+            }
+            break;
+            
+        case 'd':
+            if (presets.remove(name)) {
+                printSuccess("Preset '" + name + "' deleted");
+            } else {
+                printError("Unknown preset: " + name);
+            }
+            break;
+            
+        case 'l':
+            listPresets();
+            break;
+            
+        default:
+            printError("Unknown preset command: p" + value);
+            printInfo("Type '?' for help");
+            break;
+    }
+}
+
+void handleTempCompCommand(String value) {
+    if (value.length() == 0) {
+        showTempComp();
+        return;
+    }
+    
+    char option = value[0];
+    String argument = value.substring(1);
+    argument.trim();
+    float number;
+    
+    switch (option) {
+        case '1':
+        case '0':
+            tempComp.setEnabled(option == '1');
+            printSuccess("Temperature compensation " + String(option == '1' ? "enabled" : "disabled"));
+            break;
+            
+        case 'k':
+            if (!parseNumber(argument, number)) {
+                printError("Invalid coefficient: " + argument);
+                return;
+            }
+            tempComp.setCoefficient(number);
+            printSuccess("Coefficient set to " + String(tempComp.getCoefficient(), 2) + " steps/C");
+            break;
+            
+        case 's':
+            if (!parseNumber(argument, number)) {
+                printError("Invalid temperature: " + argument);
+                return;
+            }
+            tempComp.addSample(number, millis());
+            printSuccess("Temperature sample: " + String(tempComp.getTemperature(), 2) + " C");
+            break;
+            
+        case 'b':
+            tempComp.setBatchSteps(argument.toInt());
+            printSuccess("Minimum correction set to " + String(tempComp.getBatchSteps()) + " steps");
+            break;
+            
+        case 'i':
+            tempComp.setInterval(argument.toInt());
+            printSuccess("Minimum interval set to " + String(tempComp.getInterval()) + " s");
+            break;
+            
+        case 'm':
+            tempComp.setMaxStep(argument.toInt());
+            printSuccess("Maximum correction set to " + String(tempComp.getMaxStep()) + " steps");
+            break;
+            
+        default:
+            printError("Unknown temperature compensation command: tc" + value);
+            printInfo("Type '?' for help");
+            break;
+    }
+}
+
+void handleBacklashCommand(String value) {
+    if (!focuser.connected) {
+        printError("Focuser not connected");
+        return;
+    }
+    
+    if (value.length() == 0) {
+        showBacklash();
+        return;
+    }
+    
+    char option = value[0];
+    String argument = value.substring(1);
+    argument.trim();
+    
+    switch (option) {
+        case 'p':
+        case 'n':
+            {
+                uint8_t positive, negative;
+                if (!backlash.readFirmwareBacklash(positive, negative)) {
+                    printError("Failed to read firmware backlash");
+                    return;
+                }
+                
+                uint32_t amount = parsePosition(argument);
+                if ((amount == 0 && argument != "0") || amount > BACKLASH_FIRMWARE_MAX) {
+                    printError("Invalid backlash (0-" + String(BACKLASH_FIRMWARE_MAX) + "): " + argument);
+                    return;
+                }
+                
+                if (option == 'p') {
+                    positive = amount;
+                } else {
+                    negative = amount;
+                }
+                
+                if (backlash.writeFirmwareBacklash(positive, negative)) {
+                    printSuccess("Firmware backlash set to +" + String(positive) + " / -" + String(negative));
+                } else {
+                    printError("Failed to write firmware backlash");
+                }
+            }
+            break;
+            
+        case 'o':
+            {
+                uint32_t steps = parsePosition(argument);
+                if ((steps == 0 && argument != "0") || steps > BACKLASH_OVERSHOOT_MAX) {
+                    printError("Invalid overshoot (0-" + String(BACKLASH_OVERSHOOT_MAX) + "): " + argument);
+                    return;
+                }
+                backlash.setOvershoot(steps);
+                printSuccess("Software overshoot set to " + String(steps) + " steps");
+            }
+            break;
+            
+        case 'a':
+            if (argument == "+") {
+                backlash.setApproachDirection(BacklashManager::APPROACH_POSITIVE);
+            } else if (argument == "-") {
+                backlash.setApproachDirection(BacklashManager::APPROACH_NEGATIVE);
+            } else {
+                printError("Invalid approach direction (use ba+ or ba-): " + argument);
+                return;
+            }
+            printSuccess("Final approach direction set to " + argument);
+            break;
+            
+        case 'm':
+            // bm starts, bmn## steps back, bmy confirms; 's' aborts
+            if (argument.length() == 0) {
+                if (!focuser.connected || focuser.moving || !motionAllowed() || !startBacklashMeasurement()) {
+                    printError("Backlash measurement not started");
+                }
+            } else if (argument[0] == 'n') {
+                uint32_t steps = (argument.length() > 1) ? parsePosition(argument.substring(1)) : BACKLASH_MEASURE_INCREMENT;
+                if (steps == 0) {
+                    printError("Invalid step count: " + argument.substring(1));
+                    return;
+                }
+                stepBacklashMeasurement(steps);
+            } else if (argument == "y") {
+                uint32_t steps;
+                confirmBacklashMeasurement(steps);
+            } else {
+                printError("Unknown backlash measurement command: bm" + argument);
+            }
+            break;
+            
+        default:
+            printError("Unknown backlash command: b" + value);
+            printInfo("Type '?' for help");
+            break;
+    }
+}
+
+void handleLimitsCommand(String value) {
+    char option = value[0];
+    String argument = value.substring(1);
+    argument.trim();
+    
+    switch (option) {
+        case 'n':
+        case 'x':
+            {
+                uint32_t position = parsePosition(argument);
+                if ((position == 0 && argument != "0") || position > FOCUSER_POSITION_MAX) {
+                    printError("Invalid limit position: " + argument);
+                    return;
+                }
+                
+                uint32_t minimum = (option == 'n') ? position : limits.getSoftMin();
+                uint32_t maximum = (option == 'x') ? position : limits.getSoftMax();
+                if (limits.setSoftLimits(minimum, maximum)) {
+                    printSuccess("Soft limits set to " + String(minimum) + " - " + String(maximum));
+                } else {
+                    printError("Soft minimum must be below soft maximum and the range must overlap the hard stops");
+                }
+            }
+            break;
+            
+        case 'r':
+            limits.clearSoftLimits();
+            printSuccess("Soft limits cleared");
+            break;
+            
+        case 'h':
+            if (!focuser.connected) {
+                printError("Focuser not connected");
+                return;
+            }
+            if (limits.readHardStops()) {
+                printSuccess("Hard stops: " + String(limits.getHardMin()) + " - " + String(limits.getHardMax()));
+            } else {
+                printError("Hard stops not available (focuser not calibrated?)");
+            }
+            break;
+            
+        default:
+            printError("Unknown limits command: l" + value);
+            printInfo("Type '?' for help");
+            break;
     }
 }
 
@@ -442,7 +921,7 @@ bool initializeFocuser() {
     unsigned long startTime = millis();
     bool success = false;
     
-    if (communicator.sendCommand(auxSerial, Target::FOCUSER, Command::GET_VER, reply)) {
+    if (communicator.sendCommand(auxPort, Target::FOCUSER, Command::GET_VER, reply)) {
         if (reply.size() >= 2) {
             printSuccess("Firmware Version: " + String(reply[0]) + "." + String(reply[1]));
             if (reply.size() >= 4) {
@@ -450,6 +929,16 @@ bool initializeFocuser() {
                 printInfo("Build: " + String(build));
             }
             success = true;
+            
+            // Seed the tracked position model
+            if (getFocuserPosition()) {
+                printInfo("Position: " + String(focuser.position));
+            }
+            
+            // Calibrated travel range, if the focuser has one
+            if (limits.readHardStops()) {
+                printInfo("Hard stops: " + String(limits.getHardMin()) + " - " + String(limits.getHardMax()));
+            }
         } else {
             printError("Invalid version response (too short)");
         }
@@ -466,9 +955,11 @@ bool initializeFocuser() {
 
 bool getFocuserPosition() {
     Buffer reply;
-    if (communicator.sendCommand(auxSerial, Target::FOCUSER, Command::MC_GET_POSITION, reply)) {
+    if (communicator.sendCommand(auxPort, Target::FOCUSER, Command::MC_GET_POSITION, reply)) {
         if (reply.size() >= 3) {
-            currentPosition = (reply[0] << 16) + (reply[1] << 8) + reply[2];
+            focuser.position = (reply[0] << 16) + (reply[1] << 8) + reply[2];
+            lastPositionRead = millis();
+            tracker.update(focuser.position, lastPositionRead);
             return true;
         }
     }
@@ -481,42 +972,109 @@ bool moveFocuser(uint8_t direction, uint8_t speed) {
     Buffer reply;
     
     // MC_MOVE_POS and MC_MOVE_NEG expect a response from the focuser
-    return communicator.sendCommand(auxSerial, Target::FOCUSER, cmd, data, reply);
+    return communicator.sendCommand(auxPort, Target::FOCUSER, cmd, data, reply);
 }
 
-bool stepFocuser(uint8_t direction, uint32_t steps, uint8_t speed) {
-    // Get current position
-    uint32_t startPosition = currentPosition;
-    uint32_t targetPosition;
-    
-    if (direction == 1) {
-        targetPosition = startPosition + steps;
-    } else {
-        // Handle underflow
-        if (steps > startPosition) {
-            targetPosition = 0;
-        } else {
-            targetPosition = startPosition - steps;
-        }
+bool startMove(uint8_t direction, uint8_t speed) {
+    finishMotion(false, "superseded");
+    if (!moveFocuser(direction, speed)) {
+        return false;
     }
     
+    unsigned long now = millis();
+    tempComp.rebase();
+    watchdog.startContinuous(tracker.estimate(now), direction, now, tracker.measuredVelocity(speed));
+    tracker.startContinuous(direction, speed, now);
+    focuser.moving = true;
+    return true;
+}
+
+bool stepFocuser(uint8_t direction, uint32_t steps, uint8_t speed) {
+    // Resolve against the tracked position; during a slew this chains from
+    // the pending target so rapid clicks accumulate without a position query
+    uint32_t target = tracker.relativeTarget(direction, steps, millis());
+    
     // Use goto command for precise stepping
-    return gotoPosition(targetPosition);
+    if (!startGoto(target, backlash.getApproachDirection(), speed)) {
+        return false;
+    }
+    tempComp.rebase();
+    return true;
 }
 
-bool gotoPosition(uint32_t position) {
+bool gotoPosition(uint32_t position, uint8_t speed) {
     Buffer data = {
         static_cast<uint8_t>((position >> 16) & 0xFF),
         static_cast<uint8_t>((position >> 8) & 0xFF),
         static_cast<uint8_t>(position & 0xFF)
     };
     
-    return communicator.commandBlind(auxSerial, Target::FOCUSER, Command::MC_GOTO_FAST, data);
+    // MC_GOTO_FAST runs at the focuser's fast rate, low speeds use MC_GOTO_SLOW
+    Command cmd = (speed > GOTO_SLOW_MAX_SPEED) ? Command::MC_GOTO_FAST : Command::MC_GOTO_SLOW;
+    return communicator.commandBlind(auxPort, Target::FOCUSER, cmd, data);
+}
+
+uint8_t gotoRate(uint8_t speed) {
+    // Rate slot of the goto command gotoPosition() sends for this speed
+    return (speed > GOTO_SLOW_MAX_SPEED) ? RATE_GOTO_FAST : RATE_GOTO_SLOW;
+}
+
+bool startGoto(uint32_t position) {
+    return startGoto(position, backlash.getApproachDirection(), GOTO_FAST_SPEED);
+}
+
+bool startGoto(uint32_t position, uint8_t approach, uint8_t speed) {
+    // A goto still waiting for its completion event will not reach its target
+    finishMotion(false, "superseded");
+    
+    // Never command a target outside the hard stops or soft limits
+    if (!limits.contains(position)) {
+        position = limits.clamp(position);
+        printInfo("Target clamped to limit: " + String(position));
+    }
+    
+    // Overshoot first when software backlash compensation requires it;
+    // checkFocuserStatus() issues the final leg once the first one completes
+    unsigned long now = millis();
+    uint32_t from = tracker.estimate(now);
+    uint32_t firstLeg;
+    bool overshoot = backlash.planApproach(from, position, approach, firstLeg);
+    
+    uint32_t leg = overshoot ? limits.clamp(firstLeg) : position;
+    if (!gotoPosition(leg, speed)) {
+        return false;
+    }
+    watchdog.startGoto(from, leg, now, tracker.measuredVelocity(gotoRate(speed)));
+    tracker.startGoto(leg, position, gotoRate(speed), now);
+    gotoSpeed = speed;
+    
+    if (overshoot) {
+        printInfo("Backlash: overshooting to " + String(firstLeg) + " before final approach");
+    }
+    
+    finalLegPending = overshoot;
+    focuser.target = position;
+    focuser.moving = true;
+    return true;
 }
 
-bool stopFocuser() {
+bool stopFocuser(const char* reason) {
+    if (calibrating) {
+        abortCalibration(reason);
+    }
+    finishMotion(false, reason);
+    finalLegPending = false;
+    watchdog.stop();
+    tracker.stop(millis());
+    
     Buffer data = {0};
-    return communicator.commandBlind(auxSerial, Target::FOCUSER, Command::MC_MOVE_POS, data);
+    bool stopped = communicator.commandBlind(auxPort, Target::FOCUSER, Command::MC_MOVE_POS, data);
+    
+    // Firmware backlash is restored once the motor has been told to stop
+    if (measuringBacklash) {
+        endBacklashMeasurement(false, reason);
+    }
+    return stopped;
 }
 
 bool setSpeed(uint8_t speed) {
@@ -527,12 +1085,12 @@ bool setSpeed(uint8_t speed) {
 }
 
 bool checkFocuserStatus() {
-    if (!isMoving) {
+    if (!focuser.moving) {
         return true;
     }
     
     Buffer reply;
-    if (communicator.sendCommand(auxSerial, Target::FOCUSER, Command::MC_SLEW_DONE, reply)) {
+    if (communicator.sendCommand(auxPort, Target::FOCUSER, Command::MC_SLEW_DONE, reply)) {
         if (!reply.empty()) {
             uint8_t status = reply[0];
             bool stillMoving = (status != 0xFF);
@@ -541,10 +1099,49 @@ bool checkFocuserStatus() {
             Serial.printf("DEBUG: MC_SLEW_DONE status = 0x%02X, stillMoving = %s\n", 
                          status, stillMoving ? "true" : "false");
             
-            if (!stillMoving) {
-                isMoving = false;
+            if (!stillMoving && finalLegPending) {
+                // Overshoot leg finished, run the final approach
+                finalLegPending = false;
+                getFocuserPosition();
+                printInfo("Backlash: final approach from " + String(focuser.position) + " to " + String(focuser.target));
+                if (gotoPosition(focuser.target, gotoSpeed)) {
+                    unsigned long now = millis();
+                    watchdog.startGoto(focuser.position, focuser.target, now,
+                                       tracker.measuredVelocity(gotoRate(gotoSpeed)));
+                    tracker.startGoto(focuser.target, focuser.target, gotoRate(gotoSpeed), now);
+                } else {
+                    focuser.moving = false;
+                    watchdog.stop();
+                    tracker.stop(millis());
+                    printError("Final approach failed");
+                    finishMotion(false, "final approach failed");
+                }
+            } else if (!stillMoving) {
+                focuser.moving = false;
+                watchdog.stop();
+                tracker.stop(millis());
                 getFocuserPosition();  // Update current position
-                printSuccess("Focuser reached target position: " + String(currentPosition));
+                printSuccess("Focuser reached target position: " + String(focuser.position));
+                if (wifiInitialized) {
+                    wifiManager.broadcastMoveComplete(focuser.position, focuser.target);
+                }
+                finishMotion(true, nullptr);
+            } else if (++statusCheckCount % WATCHDOG_SAMPLE_DIVIDER == 0) {
+                // In-flight position sample for the motion watchdog
+                if (getFocuserPosition()) {
+                    MotionFault fault = watchdog.sample(focuser.position, millis());
+                    if (fault != FAULT_NONE) {
+                        handleMotionFault(fault);
+                    } else if (!tracker.hasTarget() &&
+                               ((tracker.direction() > 0 && focuser.position >= limits.getMax()) ||
+                                (tracker.direction() < 0 && focuser.position <= limits.getMin()))) {
+                        // Continuous moves have no target: stop at the limit they head for
+                        stopFocuser();
+                        focuser.moving = false;
+                        printInfo("Limit reached at position " + String(focuser.position));
+                        broadcastFocuserStatus();
+                    }
+                }
             }
         }
     }
@@ -552,45 +1149,244 @@ bool checkFocuserStatus() {
     return true;
 }
 
-// ============================================================================
-// Utility Functions
-// ============================================================================
-
-void displayHelp() {
-    printInfo("Available Commands:");
-    printInfo("  +     - Move focuser INWARD (continuous)");
-    printInfo("  -     - Move focuser OUTWARD (continuous)");
-    printInfo("  s, 0  - Stop movement");
-    printInfo("  p     - Get current position");
-    printInfo("  g#### - Go to absolute position (e.g., g5000)");
-    printInfo("  1-9   - Set motor speed (1=slowest, 9=fastest)");
-    printInfo("  c     - Connect to focuser (retry connection)");
-    printInfo("  d     - Run diagnostics (troubleshoot connection)");
-    printInfo("  t     - Test different baud rates");
-    printInfo("  w     - Show WiFi status and web interface URL");
-    printInfo("  ?     - Show this help");
-    printInfo("  i     - Show status information");
-    printInfo("");
+void handleMotionFault(MotionFault fault) {
+    finishMotion(false, MotionWatchdog::faultName(fault));
+    stopFocuser(MotionWatchdog::faultName(fault));
+    focuser.moving = false;
+    focuserFault = fault;
     
-    if (wifiInitialized) {
-        printInfo("WiFi Web Interface:");
-        printInfo("  URL: http://" + wifiManager.getIPAddress());
-        printInfo("  Use web interface to configure WiFi settings");
-        printInfo("");
-    }
+    printError("Motion fault: " + String(MotionWatchdog::faultName(fault)) +
+               " at position " + String(focuser.position) + " (target " + String(focuser.target) + ")");
+    printInfo("Motor stopped. Use 'f' to clear the fault");
+    broadcastFocuserStatus();
 }
 
-void displayStatus() {
-    printInfo("Focuser Status:");
-    printInfo("  Connected: " + String(focuserConnected ? "Yes" : "No"));
-    printInfo("  Current Position: " + String(currentPosition));
-    printInfo("  Target Position: " + String(targetPosition));
-    printInfo("  Current Speed: " + String(currentSpeed));
-    printInfo("  Moving: " + String(isMoving ? "Yes" : "No"));
-    printInfo("");
-    
-    if (wifiInitialized) {
-        printInfo("WiFi Status:");
+bool motionAllowed() {
+    if (focuserFault != FAULT_NONE) {
+        printError("Motion fault active (" + String(MotionWatchdog::faultName(focuserFault)) + ") - clear with 'f'");
+        return false;
+    }
+    if (calibrating) {
+        printError("Calibration in progress - stop it with 's'");
+        return false;
+    }
+    if (measuringBacklash) {
+        printError("Backlash measurement in progress - stop it with 's'");
+        return false;
+    }
+    return true;
+}
+
+void finishMotion(bool success, const char* message) {
+    // Completion event for WebSocket clients waiting on a goto or step
+    if (wifiInitialized) {
+        wifiManager.finishOperations(CMD_FLAG_MOTION, success, message, trackedPosition());
+    }
+}
+
+bool startCalibration() {
+    // The focuser drives to both hard stops on its own
+    Buffer data = {0};
+    if (!communicator.commandBlind(auxPort, Target::FOCUSER, Command::FOC_CALIB_ENABLE, data)) {
+        return false;
+    }
+    
+    calibrating = true;
+    calibrationStart = millis();
+    lastCalibrationCheck = calibrationStart;
+    printInfo("Calibration started");
+    return true;
+}
+
+void checkCalibration() {
+    // FOC_CALIB_DONE: [0] done, [1] state 0-12
+    Buffer reply;
+    bool done = communicator.sendCommand(auxPort, Target::FOCUSER, Command::FOC_CALIB_DONE, reply) &&
+                !reply.empty() && reply[0] != 0;
+    if (!done) {
+        if (millis() - calibrationStart >= CALIBRATION_TIMEOUT) {
+            abortCalibration("timeout");
+        }
+        return;
+    }
+    
+    calibrating = false;
+    getFocuserPosition();
+    bool success = limits.readHardStops();
+    if (success) {
+        printSuccess("Calibration complete, hard stops: " + String(limits.getHardMin()) + " - " + String(limits.getHardMax()));
+    } else {
+        printError("Calibration finished but the hard stops could not be read");
+    }
+    
+    if (wifiInitialized) {
+        wifiManager.finishOperations(CMD_FLAG_CALIBRATION, success, success ? nullptr : "hard stops unavailable",
+                                     trackedPosition());
+    }
+    broadcastFocuserStatus();
+}
+
+void abortCalibration(const char* reason) {
+    Buffer data = {1};
+    communicator.commandBlind(auxPort, Target::FOCUSER, Command::FOC_CALIB_ENABLE, data);
+    calibrating = false;
+    getFocuserPosition();
+    printError("Calibration aborted (" + String(reason) + ")");
+    
+    if (wifiInitialized) {
+        wifiManager.finishOperations(CMD_FLAG_CALIBRATION, false, reason, trackedPosition());
+    }
+}
+
+void clearMotionFault() {
+    if (focuserFault != FAULT_NONE) {
+        printSuccess("Motion fault cleared (" + String(MotionWatchdog::faultName(focuserFault)) + ")");
+    }
+    focuserFault = FAULT_NONE;
+    broadcastFocuserStatus();
+}
+
+bool applyTempCorrection(int32_t steps) {
+    // Small relative correction from the tracked position; not a user move,
+    // so the compensation reference is left alone
+    unsigned long now = millis();
+    uint8_t direction = (steps > 0) ? 1 : 0;
+    uint32_t from = tracker.estimate(now);
+    uint32_t target = limits.clamp(tracker.relativeTarget(direction, abs(steps), now));
+    
+    // Already at the limit this way: report once instead of a zero-length
+    // goto every interval
+    if (target == from) {
+        tempComp.suspendCorrection(steps);
+        printInfo("Temperature compensation suspended: " + String(steps) + " steps would pass the limit at " +
+                  String(from));
+        return false;
+    }
+    
+    printInfo("Temperature compensation: " + String(steps) + " steps at " +
+              String(tempComp.getTemperature(), 2) + " C");
+    if (!startGoto(target, backlash.getApproachDirection(), focuser.speed)) {
+        return false;
+    }
+    
+    // Count only what was commanded once the limits clamped the target
+    tempComp.commitCorrection((int32_t)focuser.target - (int32_t)from);
+    return true;
+}
+
+bool recallPreset(const String& name) {
+    const FocusPreset* preset = presets.find(name);
+    if (!preset) {
+        printError("Unknown preset: " + name);
+        return false;
+    }
+    
+    if (!motionAllowed()) {
+        return false;
+    }
+    
+    // Full approach (including software backlash) runs on the device
+    printInfo("Recalling preset '" + String(preset->name) + "': position " + String(preset->position) +
+              ", approach " + String(preset->approach == BacklashManager::APPROACH_POSITIVE ? "+" : "-") +
+              ", speed " + String(preset->speed));
+    if (backlash.getOvershoot() == 0) {
+        printInfo("No software overshoot set (bo###): the preset's approach direction is not enforced");
+    }
+    if (!startGoto(preset->position, preset->approach, preset->speed)) {
+        return false;
+    }
+    tempComp.rebase();
+    return true;
+}
+
+uint32_t trackedPosition() {
+    // Dead-reckoned while moving, last AUX reply otherwise
+    return tracker.isValid() ? tracker.estimate(millis()) : focuser.position;
+}
+
+void broadcastFocuserStatus() {
+    if (!wifiInitialized) {
+        return;
+    }
+    
+    FocuserStatus status;
+    status.connected = focuser.connected;
+    status.position = trackedPosition();
+    status.target = focuser.target;
+    status.speed = focuser.speed;
+    status.moving = focuser.moving;
+    status.faultCode = focuserFault;
+    status.fault = MotionWatchdog::faultName(focuserFault);
+    
+    // Serialized once and sent to live clients only if anything changed
+    wifiManager.broadcastFocuserStatus(status);
+}
+
+// ============================================================================
+// Utility Functions
+// ============================================================================
+
+void displayHelp() {
+    printInfo("Available Commands:");
+    printInfo("  +     - Move focuser INWARD (continuous)");
+    printInfo("  -     - Move focuser OUTWARD (continuous)");
+    printInfo("  s, 0  - Stop movement");
+    printInfo("  p     - Get current position");
+    printInfo("  g#### - Go to absolute position (e.g., g5000)");
+    printInfo("  gname - Recall focus preset (e.g., gLum)");
+    printInfo("  psname- Save current position as preset");
+    printInfo("  pdname- Delete preset");
+    printInfo("  pl    - List presets");
+    printInfo("  b     - Show backlash settings");
+    printInfo("  bp##  - Set firmware positive backlash (0-99)");
+    printInfo("  bn##  - Set firmware negative backlash (0-99)");
+    printInfo("  bo### - Set software overshoot steps (0 = off)");
+    printInfo("  ba+/- - Set final approach direction");
+    printInfo("  bm    - Measure backlash (bmn## step back, bmy movement seen)");
+    printInfo("  f     - Clear motion fault (stall/reversal/runaway)");
+    printInfo("  l     - Show travel limits");
+    printInfo("  ln### - Set soft minimum position");
+    printInfo("  lx### - Set soft maximum position");
+    printInfo("  lr    - Clear soft limits");
+    printInfo("  lh    - Re-read hard stops from focuser");
+    printInfo("  tc    - Show temperature compensation");
+    printInfo("  tc1/0 - Enable/disable temperature compensation");
+    printInfo("  tck#  - Set coefficient (steps per degree C)");
+    printInfo("  tcs#  - Supply temperature sample (degrees C)");
+    printInfo("  tcb## - Minimum correction (steps)");
+    printInfo("  tci## - Minimum interval between corrections (s)");
+    printInfo("  tcm## - Maximum single correction (steps)");
+    printInfo("  1-9   - Set motor speed (1=slowest, 9=fastest)");
+    printInfo("  c     - Connect to focuser (retry connection)");
+    printInfo("  d     - Run diagnostics (troubleshoot connection)");
+    printInfo("  t     - Test different baud rates");
+    printInfo("  w     - Show WiFi status and web interface URL");
+    printInfo("  ?     - Show this help");
+    printInfo("  i     - Show status information");
+    printInfo("");
+    
+    if (wifiInitialized) {
+        printInfo("WiFi Web Interface:");
+        printInfo("  URL: http://" + wifiManager.getIPAddress());
+        printInfo("  Use web interface to configure WiFi settings");
+        printInfo("");
+    }
+}
+
+void displayStatus() {
+    printInfo("Focuser Status:");
+    printInfo("  Connected: " + String(focuser.connected ? "Yes" : "No"));
+    printInfo("  Current Position: " + String(focuser.position));
+    printInfo("  Target Position: " + String(focuser.target));
+    printInfo("  Current Speed: " + String(focuser.speed));
+    printInfo("  Moving: " + String(focuser.moving ? "Yes" : "No"));
+    printInfo("  Fault: " + String(MotionWatchdog::faultName(focuserFault)));
+    printInfo("  JSON arena peak: " + String(auxJsonArena.getPeak()) + "/" + String(auxJsonArena.getCapacity()) +
+              " bytes, " + String(auxJsonArena.getFallbacks()) + " heap fallbacks");
+    printInfo("");
+    
+    if (wifiInitialized) {
+        printInfo("WiFi Status:");
         printInfo("  Connected: " + String(wifiManager.isConnected() ? "Yes" : "No"));
         printInfo("  Mode: " + String(wifiManager.isAPMode() ? "AP" : "Station"));
         printInfo("  SSID: " + wifiManager.getSSID());
@@ -600,6 +1396,8 @@ void displayStatus() {
             printInfo("  mDNS hostname: " + wifiManager.getmDNSHostname());
             printInfo("  Web interface (mDNS): http://" + wifiManager.getmDNSHostname());
         }
+        printInfo("  AUX bridge: port " + String(AUX_BRIDGE_PORT) + (auxBridge.isConnected() ? " (client connected)" : " (idle)") +
+                  ", " + String(auxBridge.getTransactions()) + " transactions, " + String(auxBridge.getDropped()) + " bytes dropped");
         printInfo("");
     }
 }
@@ -620,6 +1418,14 @@ uint32_t parsePosition(String value) {
     return value.toInt();
 }
 
+bool parseNumber(const String& value, float &number) {
+    // Whole argument must be a finite number, as a JSON number would be
+    const char* text = value.c_str();
+    char* end;
+    number = strtof(text, &end);
+    return end != text && *end == '\0' && isfinite(number);
+}
+
 void printError(String message) {
     Serial.println("ERROR: " + message);
 }
@@ -654,22 +1460,23 @@ void runDiagnostics() {
     
     // Send a simple test packet
     Buffer testPacket = {0x3B, 0x03, 0x20, 0x12, 0xFE, 0xCD};
-    size_t bytesWritten = auxSerial.write(testPacket.data(), testPacket.size());
-    auxSerial.flush();
+    auxPort.discard();
+    bool written = auxPort.write(testPacket.data(), testPacket.size());
     
-    printInfo("  Bytes written: " + String(bytesWritten) + "/" + String(testPacket.size()));
+    printInfo("  Bytes written: " + String(written ? testPacket.size() : 0) + "/" + String(testPacket.size()));
     
     // Check for any incoming data
     printInfo("  Checking for incoming data...");
-    delay(100);  // Wait a bit for response
+    auxPort.wait(100);  // Returns as soon as a reply burst has ended
     
-    int availableBytes = auxSerial.available();
+    int availableBytes = auxPort.available();
     printInfo("  Available bytes: " + String(availableBytes));
+    printInfo("  Receive overruns: " + String(auxPort.getOverruns()));
     
     if (availableBytes > 0) {
         printInfo("  Incoming data:");
         for (int i = 0; i < availableBytes && i < 20; i++) {
-            uint8_t byte = auxSerial.read();
+            uint8_t byte = auxPort.read();
             Serial.printf("    0x%02X ", byte);
         }
         Serial.println();
@@ -704,25 +1511,23 @@ void testBaudRates() {
         printInfo("Testing baud rate: " + String(baud));
         
         // Reinitialize AUX serial with new baud rate
-        auxSerial.end();
-        delay(100);
-        auxSerial.begin(baud, SERIAL_8N1, AUX_RX_PIN, AUX_TX_PIN);
-        delay(100);
+        auxPort.end();
+        auxPort.begin(baud, AUX_RX_PIN, AUX_TX_PIN);
         
         // Send test packet
         Buffer testPacket = {0x3B, 0x03, 0x20, 0x12, 0xFE, 0xCD};
-        auxSerial.write(testPacket.data(), testPacket.size());
-        auxSerial.flush();
+        auxPort.discard();
+        auxPort.write(testPacket.data(), testPacket.size());
         
-        // Wait for response
-        delay(200);
+        // Wait for response (no longer than a reply takes to arrive)
+        auxPort.wait(200);
         
-        int availableBytes = auxSerial.available();
+        int availableBytes = auxPort.available();
         if (availableBytes > 0) {
             printInfo("  ✓ Response received! (" + String(availableBytes) + " bytes)");
             printInfo("  Data: ");
             for (int j = 0; j < availableBytes && j < 10; j++) {
-                uint8_t byte = auxSerial.read();
+                uint8_t byte = auxPort.read();
                 Serial.printf("0x%02X ", byte);
             }
             Serial.println();
@@ -734,153 +1539,588 @@ void testBaudRates() {
     }
     
     // Restore original baud rate
-    auxSerial.end();
-    delay(100);
-    auxSerial.begin(AUX_BAUD_RATE, SERIAL_8N1, AUX_RX_PIN, AUX_TX_PIN);
-    delay(100);
+    auxPort.end();
+    auxPort.begin(AUX_BAUD_RATE, AUX_RX_PIN, AUX_TX_PIN);
     
     printInfo("Restored original baud rate: " + String(AUX_BAUD_RATE));
 }
 
 // ============================================================================
-// Web Focuser Command Handler
+// Backlash Functions
 // ============================================================================
 
-bool handleWebFocuserCommand(String command, JsonDocument& doc) {
-    printInfo("Web command: " + command);
+void showBacklash() {
+    printInfo("Backlash Settings:");
     
-    if (command == "focuser:connect") {
-        // Connect to focuser
-        if (initializeFocuser()) {
-            focuserConnected = true;
-            // Send status update to all connected clients
-            for (int i = 0; i < 8; i++) {
-                wifiManager.sendFocuserStatus(i, focuserConnected, currentPosition, targetPosition, currentSpeed, isMoving);
-            }
-            return true;
-        } else {
-            focuserConnected = false;
-            // Send status update to all connected clients
-            for (int i = 0; i < 8; i++) {
-                wifiManager.sendFocuserStatus(i, focuserConnected, currentPosition, targetPosition, currentSpeed, isMoving);
-            }
+    uint8_t positive, negative;
+    if (backlash.readFirmwareBacklash(positive, negative)) {
+        printInfo("  Firmware: +" + String(positive) + " / -" + String(negative));
+    } else {
+        printError("Failed to read firmware backlash");
+    }
+    
+    printInfo("  Software overshoot: " + String(backlash.getOvershoot()) + " steps");
+    printInfo("  Final approach: " + String(backlash.getApproachDirection() == BacklashManager::APPROACH_POSITIVE ? "+" : "-"));
+    if (backlash.getMeasuredBacklash() > 0) {
+        printInfo("  Last measurement: " + String(backlash.getMeasuredBacklash()) + " steps");
+    }
+    printInfo("");
+}
+
+void showLimits() {
+    printInfo("Travel Limits:");
+    if (limits.hasHardStops()) {
+        printInfo("  Hard stops: " + String(limits.getHardMin()) + " - " + String(limits.getHardMax()));
+    } else {
+        printInfo("  Hard stops: not reported");
+    }
+    printInfo("  Soft limits: " + String(limits.getSoftMin()) + " - " + String(limits.getSoftMax()));
+    printInfo("  Effective range: " + String(limits.getMin()) + " - " + String(limits.getMax()));
+    printInfo("");
+}
+
+void listPresets() {
+    printInfo("Focus Presets (" + String(presets.count()) + "/" + String(PRESET_MAX_COUNT) + "):");
+    for (uint8_t slot = 0; slot < PRESET_MAX_COUNT; slot++) {
+        const FocusPreset* preset = presets.get(slot);
+        if (preset) {
+            printInfo("  " + String(preset->name) + ": position " + String(preset->position) +
+                      ", approach " + String(preset->approach == BacklashManager::APPROACH_POSITIVE ? "+" : "-") +
+                      ", speed " + String(preset->speed));
         }
+    }
+    printInfo("");
+}
+
+void showTempComp() {
+    unsigned long now = millis();
+    
+    printInfo("Temperature Compensation:");
+    printInfo("  Enabled: " + String(tempComp.isEnabled() ? "Yes" : "No"));
+    if (tempComp.hasTemperature(now)) {
+        printInfo("  Temperature: " + String(tempComp.getTemperature(), 2) + " C");
+    } else {
+        printInfo("  Temperature: no recent sample");
+    }
+    printInfo("  Coefficient: " + String(tempComp.getCoefficient(), 2) + " steps/C");
+    printInfo("  Minimum correction: " + String(tempComp.getBatchSteps()) + " steps");
+    printInfo("  Minimum interval: " + String(tempComp.getInterval()) + " s");
+    printInfo("  Maximum correction: " + String(tempComp.getMaxStep()) + " steps");
+    printInfo("  Pending: " + String(tempComp.getPendingSteps()) + " steps" +
+              String(tempComp.isSuspended() ? " (suspended at a limit)" : ""));
+    printInfo("  Exposure hold: " + String(tempComp.isHeld(now) ? "Yes" : "No"));
+    printInfo("");
+}
+
+bool startBacklashMeasurement() {
+    // Preload: a positive move of BACKLASH_MEASURE_SPAN takes up the slack,
+    // then the reversal has the same span below it to find the first movement
+    if (!getFocuserPosition()) {
+        printError("Failed to read focuser position");
         return false;
     }
-    else if (command == "focuser:getPosition") {
-        // Get current position
-        if (getFocuserPosition()) {
-            // Send status update to all connected clients
-            for (int i = 0; i < 8; i++) {
-                wifiManager.sendFocuserStatus(i, focuserConnected, currentPosition, targetPosition, currentSpeed, isMoving);
-            }
-            return true;
-        }
+    uint32_t start = focuser.position;
+    if (start < limits.getMin() || start + BACKLASH_MEASURE_SPAN > limits.getMax()) {
+        printError("Measurement needs " + String(BACKLASH_MEASURE_SPAN) + " steps of travel above " +
+                   String(start) + " (limits " + String(limits.getMin()) + " - " + String(limits.getMax()) + ")");
         return false;
     }
-    else if (command == "focuser:setSpeed") {
-        // Set focuser speed
-        if (doc["speed"].is<uint8_t>()) {
-            uint8_t newSpeed = doc["speed"];
-            if (newSpeed >= 1 && newSpeed <= 9) {
-                currentSpeed = newSpeed;
-                printInfo("Speed set to: " + String(currentSpeed));
-                
-                // Send status update to all connected clients
-                for (int i = 0; i < 8; i++) {
-                    wifiManager.sendFocuserStatus(i, focuserConnected, currentPosition, targetPosition, currentSpeed, isMoving);
-                }
-                return true;
-            }
-        }
+    
+    // Firmware compensation is disabled while measuring so every reversal
+    // step is a real motor step
+    if (!backlash.readFirmwareBacklash(savedPositiveBacklash, savedNegativeBacklash)) {
+        printError("Failed to read firmware backlash");
         return false;
     }
-    else if (command == "focuser:move") {
-        // Move focuser in specified direction
-        if (doc["direction"].is<String>() && doc["speed"].is<uint8_t>()) {
-            String direction = doc["direction"];
-            uint8_t speed = doc["speed"];
-            
-            if (direction == "in") {
-                if (moveFocuser(1, speed)) {
-                    isMoving = true;
-                    // Send status update to all connected clients
-                    for (int i = 0; i < 8; i++) {
-                        wifiManager.sendFocuserStatus(i, focuserConnected, currentPosition, targetPosition, currentSpeed, isMoving);
-                    }
-                    return true;
-                }
-            } else if (direction == "out") {
-                if (moveFocuser(0, speed)) {
-                    isMoving = true;
-                    // Send status update to all connected clients
-                    for (int i = 0; i < 8; i++) {
-                        wifiManager.sendFocuserStatus(i, focuserConnected, currentPosition, targetPosition, currentSpeed, isMoving);
-                    }
-                    return true;
-                }
-            }
-        }
+    if (!backlash.writeFirmwareBacklash(0, 0)) {
+        printError("Failed to disable firmware backlash");
         return false;
     }
-    else if (command == "focuser:step") {
-        // Step focuser by specified number of steps
-        if (doc["direction"].is<String>() && doc["steps"].is<uint32_t>() && doc["speed"].is<uint8_t>()) {
-            String direction = doc["direction"];
-            uint32_t steps = doc["steps"];
-            uint8_t speed = doc["speed"];
-            
-            if (direction == "in") {
-                if (stepFocuser(1, steps, speed)) {
-                    isMoving = true;
-                    // Send status update to all connected clients
-                    for (int i = 0; i < 8; i++) {
-                        wifiManager.sendFocuserStatus(i, focuserConnected, currentPosition, targetPosition, currentSpeed, isMoving);
-                    }
-                    return true;
-                }
-            } else if (direction == "out") {
-                if (stepFocuser(0, steps, speed)) {
-                    isMoving = true;
-                    // Send status update to all connected clients
-                    for (int i = 0; i < 8; i++) {
-                        wifiManager.sendFocuserStatus(i, focuserConnected, currentPosition, targetPosition, currentSpeed, isMoving);
-                    }
-                    return true;
-                }
-            }
-        }
+    
+    // Approach in the move's own direction so no software overshoot is
+    // added; startGoto applies the limits and arms the watchdog
+    if (!startGoto(start + BACKLASH_MEASURE_SPAN, BacklashManager::APPROACH_POSITIVE, GOTO_FAST_SPEED)) {
+        backlash.writeFirmwareBacklash(savedPositiveBacklash, savedNegativeBacklash);
         return false;
     }
-    else if (command == "focuser:stop") {
-        // Stop focuser movement
-        if (stopFocuser()) {
-            isMoving = false;
-            // Send status update to all connected clients
-            for (int i = 0; i < 8; i++) {
-                wifiManager.sendFocuserStatus(i, focuserConnected, currentPosition, targetPosition, currentSpeed, isMoving);
-            }
-            return true;
-        }
+    measuringBacklash = true;
+    measureReversing = false;
+    printInfo("=== Backlash Measurement ===");
+    printInfo("Taking up slack: moving + to " + String(start + BACKLASH_MEASURE_SPAN));
+    return true;
+}
+
+void checkBacklashMeasurement() {
+    // Preload has landed: reversal steps now count from here
+    if (measureReversing) {
+        return;
+    }
+    measureReversing = true;
+    measureAnchor = focuser.position;
+    measureReversed = 0;
+    printInfo("Reversal from " + String(measureAnchor) + ": watch the star image (or the drawtube)");
+    printInfo("  bmn   - Step back " + String(BACKLASH_MEASURE_INCREMENT) + " steps (bmn## for another size)");
+    printInfo("  bmy   - The image has just started to move");
+    broadcastFocuserStatus();
+}
+
+bool stepBacklashMeasurement(uint32_t steps) {
+    if (!measuringBacklash || !measureReversing || focuser.moving) {
+        printError("No backlash measurement waiting for a step");
         return false;
     }
-    else if (command == "focuser:goto") {
-        // Go to specific position
-        if (doc["position"].is<uint32_t>()) {
-            uint32_t position = doc["position"];
-            if (gotoPosition(position)) {
-                targetPosition = position;
-                isMoving = true;
-                // Send status update to all connected clients
-                for (int i = 0; i < 8; i++) {
-                    wifiManager.sendFocuserStatus(i, focuserConnected, currentPosition, targetPosition, currentSpeed, isMoving);
-                }
-                return true;
-            }
-        }
+    
+    uint32_t reversed = measureReversed + steps;
+    if (reversed > BACKLASH_MEASURE_SPAN) {
+        endBacklashMeasurement(false, "no movement seen");
+        return false;
+    }
+    if (!startGoto(measureAnchor - reversed, BacklashManager::APPROACH_NEGATIVE, GOTO_SLOW_MAX_SPEED)) {
+        endBacklashMeasurement(false, "goto failed");
+        return false;
+    }
+    measureReversed = reversed;
+    printInfo("Reversed " + String(reversed) + " steps");
+    return true;
+}
+
+bool confirmBacklashMeasurement(uint32_t &steps) {
+    // The motor steps taken since reversing before anything moved are the backlash
+    if (!measuringBacklash || !measureReversing || focuser.moving) {
+        printError("No backlash measurement waiting for confirmation");
+        return false;
+    }
+    steps = (focuser.position < measureAnchor) ? measureAnchor - focuser.position : 0;
+    backlash.setMeasuredBacklash(steps);
+    endBacklashMeasurement(true, nullptr);
+    return true;
+}
+
+void endBacklashMeasurement(bool success, const char* reason) {
+    measuringBacklash = false;
+    measureReversing = false;
+    backlash.writeFirmwareBacklash(savedPositiveBacklash, savedNegativeBacklash);
+    
+    if (success) {
+        printSuccess("Backlash: " + String(backlash.getMeasuredBacklash()) + " steps before the first visible movement");
+    } else {
+        printError("Backlash measurement aborted (" + String(reason) + ")");
+    }
+    broadcastFocuserStatus();
+}
+
+// ============================================================================
+// Command Handlers (WebSocket, REST and serial JSON lines)
+// ============================================================================
+
+// Parameters declared in COMMANDS are validated before a handler runs
+
+bool cmdConnect(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    // Connect to focuser
+    focuser.connected = initializeFocuser();
+    broadcastFocuserStatus();
+    return focuser.connected;
+}
+
+bool cmdGetPosition(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    // A recent reading is reused, so repeated requests from many clients
+    // cost one AUX round trip at most
+    bool fresh = lastPositionRead != 0 && millis() - lastPositionRead < POSITION_CACHE_TIME;
+    if (fresh || getFocuserPosition()) {
+        response["position"] = trackedPosition();
+        broadcastFocuserStatus();
+        return true;
+    }
+    return false;
+}
+
+bool cmdSetSpeed(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    uint8_t newSpeed = args["speed"];
+    if (newSpeed < 1 || newSpeed > 9) {
+        return false;
+    }
+    focuser.speed = newSpeed;
+    printInfo("Speed set to: " + String(focuser.speed));
+    
+    broadcastFocuserStatus();
+    return true;
+}
+
+bool cmdMove(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    // Move focuser in specified direction (validated as "in" or "out")
+    uint8_t direction = (strcmp(args["direction"].as<const char*>(), "in") == 0) ? 1 : 0;
+    uint8_t speed = args["speed"] | focuser.speed;
+    
+    if (!motionAllowed()) {
+        return false;
+    }
+    
+    if (startMove(direction, speed)) {
+        broadcastFocuserStatus();
+        return true;
+    }
+    return false;
+}
+
+bool cmdStep(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    // Step focuser by specified number of steps (direction validated as "in" or "out")
+    uint8_t direction = (strcmp(args["direction"].as<const char*>(), "in") == 0) ? 1 : 0;
+    uint32_t steps = args["steps"];
+    uint8_t speed = args["speed"] | focuser.speed;
+    
+    if (!motionAllowed()) {
         return false;
     }
     
-    printError("Unknown focuser command: " + command);
+    if (stepFocuser(direction, steps, speed)) {
+        focuser.moving = true;
+        broadcastFocuserStatus();
+        return true;
+    }
+    return false;
+}
+
+bool cmdStop(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    // Stop focuser movement
+    if (stopFocuser()) {
+        focuser.moving = false;
+        broadcastFocuserStatus();
+        return true;
+    }
+    return false;
+}
+
+bool cmdGoto(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    // Go to specific position
+    uint32_t position = args["position"];
+    uint8_t speed = args["speed"] | GOTO_FAST_SPEED;
+    if (motionAllowed() && startGoto(position, backlash.getApproachDirection(), speed)) {
+        tempComp.rebase();
+        broadcastFocuserStatus();
+        return true;
+    }
+    return false;
+}
+
+bool cmdStatus(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    // Current state without an AUX round trip
+    response["connected"] = focuser.connected;
+    response["position"] = trackedPosition();
+    response["target"] = focuser.target;
+    response["speed"] = focuser.speed;
+    response["moving"] = focuser.moving;
+    response["calibrating"] = calibrating;
+    response["measuringBacklash"] = measuringBacklash;
+    response["fault"] = MotionWatchdog::faultName(focuserFault);
+    return true;
+}
+
+bool cmdGetLimits(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    response["min"] = limits.getMin();
+    response["max"] = limits.getMax();
+    response["softMin"] = limits.getSoftMin();
+    response["softMax"] = limits.getSoftMax();
+    if (limits.hasHardStops()) {
+        response["hardMin"] = limits.getHardMin();
+        response["hardMax"] = limits.getHardMax();
+    }
+    return true;
+}
+
+bool cmdSetLimits(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    // Either bound may be omitted to keep its current value
+    uint32_t minimum = args["min"] | limits.getSoftMin();
+    uint32_t maximum = args["max"] | limits.getSoftMax();
+    return limits.setSoftLimits(minimum, maximum);
+}
+
+bool cmdCalibrate(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    // Find the hard stops; WebSocket clients get an event when it is done
+    if (!focuser.connected || focuser.moving || !motionAllowed()) {
+        return false;
+    }
+    return startCalibration();
+}
+
+bool cmdClearFault(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    // Acknowledge a stall/reversal/runaway fault
+    clearMotionFault();
+    return true;
+}
+
+bool cmdRecallPreset(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    // Go to a named preset with its own approach direction and speed
+    if (recallPreset(args["name"].as<const char*>())) {
+        broadcastFocuserStatus();
+        return true;
+    }
+    return false;
+}
+
+bool cmdSavePreset(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    // Save a preset; position, approach and speed default to current values
+    uint32_t position = args["position"] | trackedPosition();
+    uint8_t approach = backlash.getApproachDirection();
+    uint8_t speed = args["speed"] | focuser.speed;
+    if (args["approach"].is<const char*>()) {
+        // Without an overshoot every goto arrives from whichever side it came from
+        if (backlash.getOvershoot() == 0) {
+            response["message"] = "approach needs a software overshoot";
+            return false;
+        }
+        approach = (strcmp(args["approach"].as<const char*>(), "in") == 0) ? BacklashManager::APPROACH_POSITIVE : BacklashManager::APPROACH_NEGATIVE;
+    }
+    return presets.save(args["name"].as<const char*>(), position, approach, speed);
+}
+
+bool cmdDeletePreset(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    return presets.remove(args["name"].as<const char*>());
+}
+
+bool cmdListPresets(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    JsonArray list = response["presets"].to<JsonArray>();
+    for (uint8_t slot = 0; slot < PRESET_MAX_COUNT; slot++) {
+        const FocusPreset* preset = presets.get(slot);
+        if (preset) {
+            JsonObject entry = list.add<JsonObject>();
+            entry["name"] = preset->name;
+            entry["position"] = preset->position;
+            entry["approach"] = (preset->approach == BacklashManager::APPROACH_POSITIVE) ? "in" : "out";
+            entry["speed"] = preset->speed;
+        }
+    }
+    return true;
+}
+
+bool cmdTempSample(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    // Ambient temperature sample from the client
+    tempComp.addSample(args["temperature"].as<float>(), millis());
+    return true;
+}
+
+bool cmdExposure(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    // Client declares an exposure; no corrections until it ends
+    uint32_t duration = args["duration"] | 0;
+    if (duration > 0) {
+        tempComp.holdFor(duration, millis());
+    } else {
+        tempComp.releaseHold();
+    }
+    return true;
+}
+
+bool cmdGetTempComp(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    unsigned long now = millis();
+    response["enabled"] = tempComp.isEnabled();
+    if (tempComp.hasTemperature(now)) {
+        response["temperature"] = tempComp.getTemperature();
+    }
+    response["coefficient"] = tempComp.getCoefficient();
+    response["batch"] = tempComp.getBatchSteps();
+    response["interval"] = tempComp.getInterval();
+    response["maxStep"] = tempComp.getMaxStep();
+    response["pending"] = tempComp.getPendingSteps();
+    response["suspended"] = tempComp.isSuspended();
+    response["held"] = tempComp.isHeld(now);
+    return true;
+}
+
+bool cmdSetTempComp(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    if (args["coefficient"].is<float>()) tempComp.setCoefficient(args["coefficient"].as<float>());
+    if (args["batch"].is<uint16_t>()) tempComp.setBatchSteps(args["batch"].as<uint16_t>());
+    if (args["interval"].is<uint16_t>()) tempComp.setInterval(args["interval"].as<uint16_t>());
+    if (args["maxStep"].is<uint16_t>()) tempComp.setMaxStep(args["maxStep"].as<uint16_t>());
+    if (args["enabled"].is<bool>()) tempComp.setEnabled(args["enabled"].as<bool>());
+    return true;
+}
+
+bool cmdGetBacklash(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    // Report firmware and software backlash settings
+    uint8_t positive, negative;
+    if (backlash.readFirmwareBacklash(positive, negative)) {
+        response["positive"] = positive;
+        response["negative"] = negative;
+        response["overshoot"] = backlash.getOvershoot();
+        response["approach"] = (backlash.getApproachDirection() == BacklashManager::APPROACH_POSITIVE) ? "in" : "out";
+        response["measured"] = backlash.getMeasuredBacklash();
+        return true;
+    }
     return false;
 }
+
+bool cmdSetBacklash(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    // Update any of the firmware or software backlash settings
+    if (args["positive"].is<uint8_t>() || args["negative"].is<uint8_t>()) {
+        uint8_t positive, negative;
+        if (!backlash.readFirmwareBacklash(positive, negative)) {
+            return false;
+        }
+        if (args["positive"].is<uint8_t>()) positive = args["positive"];
+        if (args["negative"].is<uint8_t>()) negative = args["negative"];
+        if (!backlash.writeFirmwareBacklash(positive, negative)) {
+            return false;
+        }
+    }
+    if (args["overshoot"].is<uint32_t>()) {
+        backlash.setOvershoot(args["overshoot"].as<uint32_t>());
+    }
+    if (args["approach"].is<const char*>()) {
+        // "in" is the serial UI's "+" (MC_MOVE_POS), "out" its "-"
+        const char* approach = args["approach"];
+        backlash.setApproachDirection(strcmp(approach, "in") == 0 ? BacklashManager::APPROACH_POSITIVE : BacklashManager::APPROACH_NEGATIVE);
+    }
+    return true;
+}
+
+bool cmdMeasureBacklash(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    // Preload for a user-confirmed backlash measurement
+    if (!focuser.connected || focuser.moving || !motionAllowed()) {
+        return false;
+    }
+    return startBacklashMeasurement();
+}
+
+bool cmdMeasureBacklashStep(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    // Step back towards the first visible movement
+    return stepBacklashMeasurement(args["steps"] | BACKLASH_MEASURE_INCREMENT);
+}
+
+bool cmdMeasureBacklashDone(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    // The user saw the image move: the reversal so far is the backlash
+    uint32_t steps;
+    if (!confirmBacklashMeasurement(steps)) {
+        return false;
+    }
+    response["backlash"] = steps;
+    return true;
+}
+
+bool cmdGetWiFiStatus(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    wifiManager.getWiFiStatus(response);
+    return true;
+}
+
+bool cmdGetSnapshot(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    // Client detected a gap in the delta sequence
+    if (context.source == SOURCE_WEBSOCKET) {
+        wifiManager.sendFocuserSnapshot(context.clientId);
+    }
+    return true;
+}
+
+bool cmdHello(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    if (context.source == SOURCE_WEBSOCKET) {
+        wifiManager.negotiateProtocol(context.clientId, args["protocol"] | "json");
+    }
+    return true;
+}
+
+bool cmdSubscribe(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    // Topics and rates belong to a WebSocket connection
+    if (context.source != SOURCE_WEBSOCKET || !wifiManager.subscribe(context.clientId, args["topics"], response)) {
+        response["status"] = "error";
+        response["command"] = "subscribe";
+        return false;
+    }
+    return true;
+}
+
+bool cmdSetWiFi(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    wifiManager.configureWiFi(args["ssid"], args["password"] | "", args["hostname"] | "");
+    response["status"] = "success";
+    response["message"] = "WiFi configuration saved";
+    return true;
+}
+
+bool cmdClearWiFi(const CommandContext &context, JsonDocument &args, JsonDocument &response) {
+    wifiManager.resetWiFi();
+    response["status"] = "success";
+    response["message"] = "WiFi configuration cleared";
+    return true;
+}
+
+// ============================================================================
+// Command Table
+// ============================================================================
+
+static constexpr CommandDef COMMANDS[] = {
+    // Connection and WiFi (replies built entirely by the handler)
+    {COMMAND_NAME("getStatus"),              cmdGetWiFiStatus,   CMD_FLAG_RAW, {}},
+    {COMMAND_NAME("getSnapshot"),            cmdGetSnapshot,     CMD_FLAG_RAW, {}},
+    {COMMAND_NAME("hello"),                  cmdHello,           CMD_FLAG_RAW, {{"protocol", PARAM_STRING, false}}},
+    {COMMAND_NAME("subscribe"),              cmdSubscribe,       CMD_FLAG_RAW, {{"topics", PARAM_OBJECT, true}}},
+    {COMMAND_NAME("setWiFi"),                cmdSetWiFi,         CMD_FLAG_RAW, {{"ssid", PARAM_STRING, true}, {"password", PARAM_STRING, false},
+                                                                                {"hostname", PARAM_STRING, false}}},
+    {COMMAND_NAME("clearWiFi"),              cmdClearWiFi,       CMD_FLAG_RAW, {}},
+    
+    // Motion
+    {COMMAND_NAME("focuser:connect"),        cmdConnect,         CMD_FLAG_BLOCKING, {}},
+    {COMMAND_NAME("focuser:getPosition"),    cmdGetPosition,     0, {}},
+    {COMMAND_NAME("focuser:status"),         cmdStatus,          0, {}},
+    {COMMAND_NAME("focuser:setSpeed"),       cmdSetSpeed,        0, {{"speed", PARAM_UINT8, true}}},
+    {COMMAND_NAME("focuser:move"),           cmdMove,            0, {{"direction", PARAM_DIRECTION, true}, {"speed", PARAM_UINT8, false}}},
+    {COMMAND_NAME("focuser:step"),           cmdStep,            CMD_FLAG_MOTION, {{"direction", PARAM_DIRECTION, true}, {"steps", PARAM_UINT32, true},
+                                                                     {"speed", PARAM_UINT8, false}}},
+    {COMMAND_NAME("focuser:stop"),           cmdStop,            0, {}},
+    {COMMAND_NAME("focuser:goto"),           cmdGoto,            CMD_FLAG_MOTION, {{"position", PARAM_UINT32, true}, {"speed", PARAM_UINT8, false}}},
+    {COMMAND_NAME("focuser:calibrate"),      cmdCalibrate,       CMD_FLAG_CALIBRATION, {}},
+    {COMMAND_NAME("focuser:clearFault"),     cmdClearFault,      0, {}},
+    
+    // Travel limits
+    {COMMAND_NAME("focuser:getLimits"),      cmdGetLimits,       0, {}},
+    {COMMAND_NAME("focuser:setLimits"),      cmdSetLimits,       0, {{"min", PARAM_UINT32, false}, {"max", PARAM_UINT32, false}}},
+    
+    // Presets
+    {COMMAND_NAME("focuser:recallPreset"),   cmdRecallPreset,    CMD_FLAG_MOTION, {{"name", PARAM_STRING, true}}},
+    {COMMAND_NAME("focuser:savePreset"),     cmdSavePreset,      0, {{"name", PARAM_STRING, true}, {"position", PARAM_UINT32, false},
+                                                                     {"approach", PARAM_DIRECTION, false}, {"speed", PARAM_UINT8, false}}},
+    {COMMAND_NAME("focuser:deletePreset"),   cmdDeletePreset,    0, {{"name", PARAM_STRING, true}}},
+    {COMMAND_NAME("focuser:listPresets"),    cmdListPresets,     0, {}},
+    
+    // Temperature compensation
+    {COMMAND_NAME("focuser:tempSample"),     cmdTempSample,      0, {{"temperature", PARAM_FLOAT, true}}},
+    {COMMAND_NAME("focuser:exposure"),       cmdExposure,        0, {{"duration", PARAM_UINT32, false}}},
+    {COMMAND_NAME("focuser:getTempComp"),    cmdGetTempComp,     0, {}},
+    {COMMAND_NAME("focuser:setTempComp"),    cmdSetTempComp,     0, {{"coefficient", PARAM_FLOAT, false}, {"batch", PARAM_UINT16, false},
+                                                                     {"interval", PARAM_UINT16, false}, {"maxStep", PARAM_UINT16, false},
+                                                                     {"enabled", PARAM_BOOL, false}}},
+    
+    // Backlash
+    {COMMAND_NAME("focuser:getBacklash"),    cmdGetBacklash,     0, {}},
+    {COMMAND_NAME("focuser:setBacklash"),    cmdSetBacklash,     0, {{"positive", PARAM_UINT8, false}, {"negative", PARAM_UINT8, false},
+                                                                     {"overshoot", PARAM_UINT32, false}, {"approach", PARAM_DIRECTION, false}}},
+    {COMMAND_NAME("focuser:measureBacklash"), cmdMeasureBacklash, CMD_FLAG_MOTION, {}},
+    {COMMAND_NAME("focuser:measureBacklashStep"), cmdMeasureBacklashStep, CMD_FLAG_MOTION, {{"steps", PARAM_UINT16, false}}},
+    {COMMAND_NAME("focuser:measureBacklashDone"), cmdMeasureBacklashDone, 0, {}},
+};
+
+static constexpr size_t COMMAND_COUNT = sizeof(COMMANDS) / sizeof(COMMANDS[0]);
+static constexpr uint32_t COMMAND_SEED = commandFindSeed(COMMANDS, COMMAND_COUNT);
+static_assert(COMMAND_COUNT < COMMAND_EMPTY_SLOT, "Too many commands for 8 bit slot indices");
+static_assert(COMMAND_SEED != COMMAND_NO_SEED, "No perfect hash seed: raise COMMAND_TABLE_BITS");
+
+CommandRegistry commandRegistry(COMMANDS, COMMAND_COUNT, COMMAND_SEED);
+
+void handleJsonCommand(const String& line) {
+    // Serial JSON lines run through the same table as WebSocket messages
+    JsonDocument doc(&auxJsonArena);
+    if (deserializeJson(doc, line.c_str(), line.length())) {
+        printError("Invalid JSON command: " + line);
+        return;
+    }
+    
+    const char* command = doc["command"] | "";
+    CommandContext context = {SOURCE_SERIAL, 0};
+    const CommandDef *matched;
+    JsonDocument response(&auxJsonArena);
+    CommandResult result = commandRegistry.dispatch(command, context, doc, response, &matched);
+    
+    if (!matched || !(matched->flags & CMD_FLAG_RAW)) {
+        response["status"] = (result == COMMAND_OK) ? "success" : "error";
+        response["command"] = command;
+    }
+    if (response.size() > 0) {
+        serializeJson(response, Serial);
+        Serial.println();
+    }
+}
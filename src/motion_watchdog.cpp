@@ -0,0 +1,131 @@
+/*
+    Motion Watchdog Implementation for ESP32 Celestron Focuser Controller
+
+    Copyright (C) 2024
+*/
+
+#include "motion_watchdog.h"
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+MotionWatchdog::MotionWatchdog() {
+    _active = false;
+    _hasTarget = false;
+    _direction = 1;
+    _target = 0;
+    _expectedVelocity = 0;
+    _startTime = 0;
+    _lastSampleTime = 0;
+    _lastPosition = 0;
+    _bestPosition = 0;
+    _windowStart = 0;
+    _windowPosition = 0;
+}
+
+// ============================================================================
+// Move Tracking
+// ============================================================================
+
+void MotionWatchdog::startGoto(uint32_t start, uint32_t target, unsigned long now, uint32_t velocity) {
+    _start(start, (target >= start) ? 1 : -1, now, velocity);
+    _hasTarget = true;
+    _target = target;
+}
+
+void MotionWatchdog::startContinuous(uint32_t start, uint8_t direction, unsigned long now, uint32_t velocity) {
+    _start(start, (direction == 1) ? 1 : -1, now, velocity);
+    _hasTarget = false;
+}
+
+void MotionWatchdog::_start(uint32_t start, int8_t direction, unsigned long now, uint32_t velocity) {
+    // No rate has a documented speed: until one has been measured there is
+    // no speed-based runaway check and stalls need WATCHDOG_MIN_PROGRESS
+    _active = true;
+    _direction = direction;
+    _expectedVelocity = velocity;
+    _startTime = now;
+    _lastSampleTime = now;
+    _lastPosition = start;
+    _bestPosition = start;
+    _windowStart = now;
+    _windowPosition = start;
+}
+
+void MotionWatchdog::stop() {
+    _active = false;
+}
+
+bool MotionWatchdog::isActive() {
+    return _active;
+}
+
+// ============================================================================
+// Sampling
+// ============================================================================
+
+MotionFault MotionWatchdog::sample(uint32_t position, unsigned long now) {
+    if (!_active) {
+        return FAULT_NONE;
+    }
+
+    // Runaway: speed far above what the rate allows
+    unsigned long elapsed = now - _lastSampleTime;
+    if (elapsed > 0 && _expectedVelocity > 0) {
+        uint32_t moved = (position > _lastPosition) ? position - _lastPosition : _lastPosition - position;
+        uint32_t velocity = (uint64_t)moved * 1000 / elapsed;
+        if (velocity > _expectedVelocity * WATCHDOG_RUNAWAY_FACTOR) {
+            return FAULT_RUNAWAY;
+        }
+    }
+    _lastSampleTime = now;
+    _lastPosition = position;
+
+    // Runaway: travelled well past the target
+    if (_hasTarget && _progress(_target, position) > WATCHDOG_RUNAWAY_STEPS) {
+        return FAULT_RUNAWAY;
+    }
+
+    // Reversal: fell back from the furthest point reached
+    if (_progress(_bestPosition, position) > 0) {
+        _bestPosition = position;
+    } else if (_progress(position, _bestPosition) > WATCHDOG_REVERSAL_STEPS) {
+        return FAULT_REVERSAL;
+    }
+
+    // Stall: too little progress over a full window
+    if (now - _startTime < WATCHDOG_STARTUP_GRACE_MS || now - _windowStart < WATCHDOG_STALL_WINDOW_MS) {
+        return FAULT_NONE;
+    }
+
+    bool settling = _hasTarget && abs(_progress(position, _target)) <= WATCHDOG_SETTLE_ZONE;
+    uint32_t required = max((uint32_t)WATCHDOG_MIN_PROGRESS,
+                            _expectedVelocity * WATCHDOG_STALL_WINDOW_MS / 1000 / WATCHDOG_STALL_RATIO);
+
+    if (!settling && _progress(_windowPosition, position) < (int32_t)required) {
+        return FAULT_STALL;
+    }
+
+    _windowStart = now;
+    _windowPosition = position;
+    return FAULT_NONE;
+}
+
+int32_t MotionWatchdog::_progress(uint32_t from, uint32_t to) {
+    // Signed distance from -> to, positive when in the move direction
+    return ((int32_t)to - (int32_t)from) * _direction;
+}
+
+// ============================================================================
+// Status
+// ============================================================================
+
+const char* MotionWatchdog::faultName(MotionFault fault) {
+    switch (fault) {
+        case FAULT_STALL:    return "stall";
+        case FAULT_REVERSAL: return "reversal";
+        case FAULT_RUNAWAY:  return "runaway";
+        default:             return "none";
+    }
+}
@@ -0,0 +1,77 @@
+/*
+    Motion Watchdog for ESP32 Celestron Focuser Controller
+    Detects stalled, reversing or runaway moves from in-flight position samples
+
+    Copyright (C) 2024
+*/
+
+#pragma once
+
+#include <Arduino.h>
+
+// Watchdog Configuration
+#define WATCHDOG_STARTUP_GRACE_MS   1000  // Ignore stalls while the motor accelerates
+#define WATCHDOG_STALL_WINDOW_MS    1500  // Progress is judged over this window
+#define WATCHDOG_STALL_RATIO        10    // Stall below 1/10 of expected progress
+#define WATCHDOG_MIN_PROGRESS       3     // Steps per window regardless of rate
+#define WATCHDOG_REVERSAL_STEPS     100   // Covers firmware backlash take-up (0-99)
+#define WATCHDOG_RUNAWAY_STEPS      200   // Allowed travel past the target
+#define WATCHDOG_RUNAWAY_FACTOR     5     // Allowed multiple of expected velocity
+#define WATCHDOG_SETTLE_ZONE        50    // No stall checks this close to target
+
+// Rate slots: MC_MOVE_POS/NEG rates 0-9, then the two goto commands, which
+// each run at one firmware speed whatever speed was requested
+#define RATE_GOTO_SLOW 10
+#define RATE_GOTO_FAST 11
+#define RATE_SLOTS 12
+
+/**
+ * Motion Fault Codes
+ */
+enum MotionFault {
+    FAULT_NONE = 0,
+    FAULT_STALL,                    // Position not changing while moving
+    FAULT_REVERSAL,                 // Position moving against commanded direction
+    FAULT_RUNAWAY                   // Past the target or faster than possible
+};
+
+/**
+ * Motion Watchdog Class
+ * Fed with position samples taken by the regular status poll while a move
+ * is in flight; compares progress with the velocity measured for the rate
+ */
+class MotionWatchdog {
+public:
+    // Constructor
+    MotionWatchdog();
+
+    // Move Tracking
+    // (velocity: measured steps/s for the move's rate slot, 0 if not measured yet)
+    void startGoto(uint32_t start, uint32_t target, unsigned long now, uint32_t velocity);
+    void startContinuous(uint32_t start, uint8_t direction, unsigned long now, uint32_t velocity);
+    void stop();
+    bool isActive();
+
+    // Sampling
+    MotionFault sample(uint32_t position, unsigned long now);
+
+    // Status
+    static const char* faultName(MotionFault fault);
+
+private:
+    bool _active;
+    bool _hasTarget;
+    int8_t _direction;              // +1 or -1
+    uint32_t _target;
+    uint32_t _expectedVelocity;     // Steps per second
+
+    unsigned long _startTime;
+    unsigned long _lastSampleTime;
+    uint32_t _lastPosition;
+    uint32_t _bestPosition;         // Furthest point reached in the move direction
+    unsigned long _windowStart;
+    uint32_t _windowPosition;
+
+    void _start(uint32_t start, int8_t direction, unsigned long now, uint32_t velocity);
+    int32_t _progress(uint32_t from, uint32_t to);
+};
@@ -0,0 +1,167 @@
+/*
+    Position Tracker Implementation for ESP32 Celestron Focuser Controller
+
+    Copyright (C) 2024
+*/
+
+#include "position_tracker.h"
+#include "motion_watchdog.h"
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+PositionTracker::PositionTracker() {
+    _valid = false;
+    _position = 0;
+    _positionTime = 0;
+    _moving = false;
+    _hasTarget = false;
+    _leg = 0;
+    _target = 0;
+    _direction = 1;
+    _rate = 9;
+    _moveStart = 0;
+
+    // No rate has a documented speed: dead reckoning holds still until measured
+    for (uint8_t rate = 0; rate < RATE_SLOTS; rate++) {
+        _learnedVelocity[rate] = 0;
+        _samples[rate] = 0;
+    }
+}
+
+// ============================================================================
+// AUX Updates
+// ============================================================================
+
+void PositionTracker::update(uint32_t position, unsigned long now) {
+    // Learn the real velocity from consecutive replies while moving; a
+    // sample starting inside the ramp includes command latency and
+    // acceleration, so it would understate the cruise speed
+    unsigned long elapsed = now - _positionTime;
+    if (_valid && _moving && elapsed >= TRACKER_MIN_SAMPLE_MS && _positionTime - _moveStart >= TRACKER_RAMP_MS) {
+        uint32_t moved = (position > _position) ? position - _position : _position - position;
+        uint32_t measured = (uint64_t)moved * 1000 / elapsed;
+        uint32_t &learned = _learnedVelocity[_rate];
+        uint8_t &samples = _samples[_rate];
+        if (samples < TRACKER_MIN_SAMPLES) {
+            // Plain mean until there are enough samples to trust
+            learned = (learned * samples + measured) / (samples + 1);
+            samples++;
+        } else {
+            learned = (learned * (TRACKER_VELOCITY_WEIGHT - 1) + measured) / TRACKER_VELOCITY_WEIGHT;
+        }
+    }
+
+    _valid = true;
+    _position = position;
+    _positionTime = now;
+}
+
+void PositionTracker::invalidate() {
+    _valid = false;
+    _moving = false;
+    _hasTarget = false;
+}
+
+// ============================================================================
+// Motion Updates
+// ============================================================================
+
+void PositionTracker::startGoto(uint32_t leg, uint32_t target, uint8_t rate, unsigned long now) {
+    // Re-anchor at the current estimate so chained moves dead-reckon from here
+    _position = estimate(now);
+    _positionTime = now;
+
+    _moving = true;
+    _hasTarget = true;
+    _leg = leg;
+    _target = target;
+    _direction = (leg >= _position) ? 1 : -1;
+    _rate = min(rate, (uint8_t)(RATE_SLOTS - 1));
+    _moveStart = now;
+}
+
+void PositionTracker::startContinuous(uint8_t direction, uint8_t rate, unsigned long now) {
+    _position = estimate(now);
+    _positionTime = now;
+
+    _moving = true;
+    _hasTarget = false;
+    _direction = (direction == 1) ? 1 : -1;
+    _rate = min(rate, (uint8_t)(RATE_SLOTS - 1));
+    _moveStart = now;
+}
+
+void PositionTracker::stop(unsigned long now) {
+    _position = estimate(now);
+    _positionTime = now;
+    _moving = false;
+    _hasTarget = false;
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+bool PositionTracker::isValid() {
+    return _valid;
+}
+
+bool PositionTracker::isMoving() {
+    return _moving;
+}
+
+bool PositionTracker::hasTarget() {
+    return _hasTarget;
+}
+
+uint32_t PositionTracker::pendingTarget() {
+    return _target;
+}
+
+uint32_t PositionTracker::estimate(unsigned long now) {
+    if (!_moving) {
+        return _position;
+    }
+
+    // Dead-reckon from the last known position at the learned velocity
+    int64_t travelled = (int64_t)_learnedVelocity[_rate] * (now - _positionTime) / 1000;
+    int64_t position = (int64_t)_position + _direction * travelled;
+
+    // Never extrapolate beyond the point the motor is heading for
+    if (_hasTarget) {
+        if ((_direction > 0 && position > _leg) || (_direction < 0 && position < _leg)) {
+            position = _leg;
+        }
+    }
+
+    return _clamp(position);
+}
+
+uint32_t PositionTracker::relativeTarget(uint8_t direction, uint32_t steps, unsigned long now) {
+    // Relative moves issued during a slew chain from the pending target
+    uint32_t base = (_moving && _hasTarget) ? _target : estimate(now);
+    int64_t target = (direction == 1) ? (int64_t)base + steps : (int64_t)base - steps;
+    return _clamp(target);
+}
+
+uint32_t PositionTracker::velocity() {
+    return _learnedVelocity[_rate];
+}
+
+uint32_t PositionTracker::measuredVelocity(uint8_t rate) {
+    rate = min(rate, (uint8_t)(RATE_SLOTS - 1));
+    // The watchdog's runaway threshold scales with this: never from one sample
+    return (_samples[rate] >= TRACKER_MIN_SAMPLES) ? _learnedVelocity[rate] : 0;
+}
+
+int8_t PositionTracker::direction() {
+    return _direction;
+}
+
+uint32_t PositionTracker::_clamp(int64_t position) {
+    if (position < 0) return 0;
+    if (position > TRACKER_POSITION_MAX) return TRACKER_POSITION_MAX;
+    return (uint32_t)position;
+}
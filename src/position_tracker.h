@@ -0,0 +1,66 @@
+/*
+    Position Tracker for ESP32 Celestron Focuser Controller
+    Tracked position model updated from AUX replies and dead-reckoning
+
+    Copyright (C) 2024
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include "motion_watchdog.h"
+
+// Tracker Configuration
+#define TRACKER_POSITION_MAX 0xFFFFFF   // 24 bit AUX position
+#define TRACKER_VELOCITY_WEIGHT 4       // EWMA weight for learned velocity (1/N)
+#define TRACKER_MIN_SAMPLE_MS 100       // Ignore velocity samples closer than this
+#define TRACKER_RAMP_MS 500             // Ignore samples starting this soon after a move starts
+#define TRACKER_MIN_SAMPLES 3           // Samples before a rate counts as measured
+
+/**
+ * Position Tracker Class
+ * Keeps a best estimate of the focuser position between AUX position
+ * replies so relative moves never need a MC_GET_POSITION round trip
+ */
+class PositionTracker {
+public:
+    // Constructor
+    PositionTracker();
+
+    // AUX Updates
+    void update(uint32_t position, unsigned long now);
+    void invalidate();
+
+    // Motion Updates
+    void startGoto(uint32_t leg, uint32_t target, uint8_t rate, unsigned long now);
+    void startContinuous(uint8_t direction, uint8_t rate, unsigned long now);
+    void stop(unsigned long now);
+
+    // Queries
+    bool isValid();
+    bool isMoving();
+    bool hasTarget();
+    uint32_t pendingTarget();
+    uint32_t estimate(unsigned long now);
+    uint32_t relativeTarget(uint8_t direction, uint32_t steps, unsigned long now);
+    uint32_t velocity();
+    uint32_t measuredVelocity(uint8_t rate);    // 0 until TRACKER_MIN_SAMPLES cruise samples at this rate slot
+    int8_t direction();
+
+private:
+    bool _valid;
+    uint32_t _position;             // Last known position (AUX reply or freeze)
+    unsigned long _positionTime;
+
+    bool _moving;
+    bool _hasTarget;
+    uint32_t _leg;                  // Position the motor is currently heading for
+    uint32_t _target;               // Final target of the move
+    int8_t _direction;              // +1 or -1 while moving
+    uint8_t _rate;                  // Rate slot (see RATE_SLOTS)
+    unsigned long _moveStart;       // Command time of the current move or leg
+    uint32_t _learnedVelocity[RATE_SLOTS];  // Steps per second per rate slot
+    uint8_t _samples[RATE_SLOTS];   // Cruise samples behind each learned velocity
+
+    uint32_t _clamp(int64_t position);
+};
@@ -0,0 +1,90 @@
+/*
+    Cooperative Scheduler Implementation for ESP32 Celestron Focuser Controller
+
+    Copyright (C) 2024
+*/
+
+#include "scheduler.h"
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+Scheduler::Scheduler() {
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        _slots[i].start = 0;
+        _slots[i].delay = 0;
+        _slots[i].used = false;
+    }
+}
+
+// ============================================================================
+// Scheduling
+// ============================================================================
+
+bool Scheduler::after(uint32_t delayMs, ScheduledTask task) {
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        Slot &slot = _slots[i];
+        if (!slot.used) {
+            slot.task = task;
+            slot.start = millis();
+            slot.delay = delayMs;
+            slot.used = true;
+            return true;
+        }
+    }
+
+    Serial.println("ERROR: Scheduler full");
+    return false;
+}
+
+// ============================================================================
+// Main Loop
+// ============================================================================
+
+void Scheduler::run() {
+    unsigned long now = millis();
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        Slot &slot = _slots[i];
+        if (!slot.used || now - slot.start < slot.delay) {
+            continue;
+        }
+
+        // Free the slot first: the task may schedule its own next step
+        ScheduledTask task = slot.task;
+        slot.task = nullptr;
+        slot.used = false;
+        task();
+    }
+}
+
+uint32_t Scheduler::idleTime(uint32_t limit) {
+    unsigned long now = millis();
+    uint32_t idle = limit;
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        const Slot &slot = _slots[i];
+        if (!slot.used) {
+            continue;
+        }
+        unsigned long elapsed = now - slot.start;
+        if (elapsed >= slot.delay) {
+            return 0;
+        }
+        idle = min(idle, (uint32_t)(slot.delay - elapsed));
+    }
+    return idle;
+}
+
+// ============================================================================
+// Status
+// ============================================================================
+
+uint8_t Scheduler::pending() {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        if (_slots[i].used) {
+            count++;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,48 @@
+/*
+    Cooperative Scheduler for ESP32 Celestron Focuser Controller
+    One-shot continuations instead of delay()
+
+    Copyright (C) 2024
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include <functional>
+
+// Scheduler Configuration
+#define SCHEDULER_MAX_TASKS 8           // Continuations waiting at once
+
+typedef std::function<void()> ScheduledTask;
+
+/**
+ * Scheduler Class
+ * Fixed table of one-shot timers run from a single task's loop. Code that
+ * has to wait schedules its next step and returns instead of sleeping, and
+ * the loop sleeps only until the next step is due. Not thread safe: only
+ * the owning task schedules and runs.
+ */
+class Scheduler {
+public:
+    // Constructor
+    Scheduler();
+
+    // Scheduling (false if the table is full)
+    bool after(uint32_t delayMs, ScheduledTask task);
+
+    // Main loop
+    void run();
+    uint32_t idleTime(uint32_t limit);  // ms until the next task is due, at most limit
+
+    // Status
+    uint8_t pending();
+
+private:
+    struct Slot {
+        ScheduledTask task;
+        unsigned long start;
+        uint32_t delay;
+        bool used;
+    };
+    Slot _slots[SCHEDULER_MAX_TASKS];
+};
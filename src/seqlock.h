@@ -0,0 +1,57 @@
+/*
+    Sequence Lock for ESP32 Celestron Focuser Controller
+    Consistent lock-free snapshots of a value with a single writer
+
+    Copyright (C) 2024
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+/**
+ * Seqlock Template
+ * The writer bumps the sequence to odd, copies the value in and bumps it
+ * back to even; it never waits. Readers copy the value and retry if the
+ * sequence was odd or moved while they copied. T must be trivially
+ * copyable, and readers must not preempt the writer on its own core.
+ */
+template <typename T>
+class Seqlock {
+public:
+    // Constructor
+    Seqlock() : _sequence(0), _value() {}
+
+    // Writer (one task only)
+    void write(const T &value) {
+        uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+        _sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        _value = value;
+        _sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    // Readers (any task)
+    T read() const {
+        T value;
+        uint32_t before;
+        uint32_t after;
+        do {
+            before = _sequence.load(std::memory_order_acquire);
+            value = _value;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = _sequence.load(std::memory_order_relaxed);
+        } while ((before & 1) || before != after);
+        return value;
+    }
+
+    // Writes so far (readers can tell whether anything changed)
+    uint32_t version() const {
+        return _sequence.load(std::memory_order_acquire) >> 1;
+    }
+
+private:
+    std::atomic<uint32_t> _sequence;
+    T _value;
+};
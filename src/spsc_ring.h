@@ -0,0 +1,103 @@
+/*
+    Lock-Free Ring Buffer for ESP32 Celestron Focuser Controller
+    Single-producer/single-consumer hand-off between tasks
+
+    Copyright (C) 2024
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Indices sit on separate cache lines so the two cores do not share one
+#define SPSC_CACHE_LINE 32
+
+/**
+ * SPSC Ring Template
+ * One task pushes, one task pops; neither ever blocks, locks or allocates.
+ * Indices run freely and are masked on access, so all Capacity slots are
+ * usable. The producer publishes with a release store of _head and the
+ * consumer frees slots with a release store of _tail. Plain C++11 so the
+ * host tests in test/ build it too.
+ */
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+    // Constructor
+    SpscRing() : _head(0), _tail(0) {}
+
+    // Producer
+    bool push(const T &item) {
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        _items[head & MASK] = item;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t push(const T *items, size_t count) {
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        size_t room = Capacity - (head - _tail.load(std::memory_order_acquire));
+        size_t pushed = std::min(count, room);
+        for (size_t i = 0; i < pushed; i++) {
+            _items[(head + i) & MASK] = items[i];
+        }
+        _head.store(head + pushed, std::memory_order_release);
+        return pushed;
+    }
+
+    // Consumer
+    bool pop(T &item) {
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        if (_head.load(std::memory_order_acquire) == tail) {
+            return false;
+        }
+        item = _items[tail & MASK];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t pop(T *items, size_t count) {
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        size_t waiting = _head.load(std::memory_order_acquire) - tail;
+        size_t popped = std::min(count, waiting);
+        for (size_t i = 0; i < popped; i++) {
+            items[i] = _items[(tail + i) & MASK];
+        }
+        _tail.store(tail + popped, std::memory_order_release);
+        return popped;
+    }
+
+    void clear() {
+        _tail.store(_head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    // Either side (a snapshot: the other side may move it on)
+    size_t size() const {
+        // Tail first: _head can only be further on by the time it is read
+        uint32_t tail = _tail.load(std::memory_order_acquire);
+        return _head.load(std::memory_order_acquire) - tail;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    static constexpr size_t capacity() {
+        return Capacity;
+    }
+
+private:
+    static const uint32_t MASK = Capacity - 1;
+
+    alignas(SPSC_CACHE_LINE) std::atomic<uint32_t> _head;     // Written by the producer
+    alignas(SPSC_CACHE_LINE) std::atomic<uint32_t> _tail;     // Written by the consumer
+    T _items[Capacity];
+};
@@ -0,0 +1,251 @@
+/*
+    Temperature Compensation Implementation for ESP32 Celestron Focuser Controller
+
+    Copyright (C) 2024
+*/
+
+#include "temp_compensation.h"
+
+#ifdef TEMP_SENSOR_ONEWIRE_PIN
+#include <OneWire.h>
+#include <DallasTemperature.h>
+
+static OneWire oneWire(TEMP_SENSOR_ONEWIRE_PIN);
+static DallasTemperature tempSensor(&oneWire);
+#endif
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+TempCompensator::TempCompensator() {
+    _enabled = false;
+    _coefficient = TEMPCOMP_DEFAULT_COEFF;
+    _batchSteps = TEMPCOMP_DEFAULT_BATCH;
+    _interval = TEMPCOMP_DEFAULT_INTERVAL;
+    _maxStep = TEMPCOMP_DEFAULT_MAXSTEP;
+
+    _hasSample = false;
+    _temperature = 0.0f;
+    _sampleTime = 0;
+
+    _hasReference = false;
+    _referenceTemperature = 0.0f;
+    _appliedSteps = 0;
+    _lastCorrection = 0;
+    _suspendedDirection = 0;
+    _held = false;
+    _holdStart = 0;
+    _holdDuration = 0;
+
+    _conversionPending = false;
+    _conversionStart = 0;
+}
+
+// ============================================================================
+// Initialization
+// ============================================================================
+
+void TempCompensator::begin() {
+    _preferences.begin(TEMPCOMP_PREF_NAMESPACE, false);
+
+    _enabled = _preferences.getBool(PREF_TC_ENABLED_KEY, false);
+    _coefficient = _preferences.getFloat(PREF_TC_COEFF_KEY, TEMPCOMP_DEFAULT_COEFF);
+    _batchSteps = _preferences.getUShort(PREF_TC_BATCH_KEY, TEMPCOMP_DEFAULT_BATCH);
+    _interval = _preferences.getUShort(PREF_TC_INTERVAL_KEY, TEMPCOMP_DEFAULT_INTERVAL);
+    _maxStep = _preferences.getUShort(PREF_TC_MAXSTEP_KEY, TEMPCOMP_DEFAULT_MAXSTEP);
+
+#ifdef TEMP_SENSOR_ONEWIRE_PIN
+    tempSensor.begin();
+    tempSensor.setWaitForConversion(false);  // Never block the loop on a conversion
+    Serial.println("INFO: DS18B20 sensors found: " + String(tempSensor.getDeviceCount()));
+#endif
+
+    Serial.println("INFO: Temperature compensation " + String(_enabled ? "enabled" : "disabled") +
+                   ", " + String(_coefficient, 2) + " steps/C");
+}
+
+// ============================================================================
+// Temperature Samples
+// ============================================================================
+
+void TempCompensator::addSample(float celsius, unsigned long now) {
+    if (!_hasSample || now - _sampleTime > TEMPCOMP_SAMPLE_TIMEOUT_MS) {
+        _temperature = celsius;
+    } else {
+        _temperature += (celsius - _temperature) / TEMPCOMP_SMOOTHING;
+    }
+
+    _hasSample = true;
+    _sampleTime = now;
+
+    // First sample after enabling becomes the reference
+    if (!_hasReference) {
+        rebase();
+    }
+}
+
+void TempCompensator::pollSensor(unsigned long now) {
+#ifdef TEMP_SENSOR_ONEWIRE_PIN
+    if (!_conversionPending) {
+        if (now - _conversionStart >= TEMP_SENSOR_INTERVAL_MS) {
+            tempSensor.requestTemperatures();
+            _conversionPending = true;
+            _conversionStart = now;
+        }
+    } else if (now - _conversionStart >= TEMP_SENSOR_CONVERSION_MS) {
+        _conversionPending = false;
+        float celsius = tempSensor.getTempCByIndex(0);
+        if (celsius != DEVICE_DISCONNECTED_C) {
+            addSample(celsius, now);
+        }
+    }
+#else
+    (void)now;
+#endif
+}
+
+bool TempCompensator::hasTemperature(unsigned long now) {
+    return _hasSample && now - _sampleTime <= TEMPCOMP_SAMPLE_TIMEOUT_MS;
+}
+
+float TempCompensator::getTemperature() {
+    return _temperature;
+}
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+void TempCompensator::setEnabled(bool enabled) {
+    if (enabled && !_enabled) {
+        rebase();  // Current focus is correct at the current temperature
+    }
+    _enabled = enabled;
+    _preferences.putBool(PREF_TC_ENABLED_KEY, _enabled);
+}
+
+bool TempCompensator::isEnabled() {
+    return _enabled;
+}
+
+void TempCompensator::setCoefficient(float stepsPerDegree) {
+    _coefficient = stepsPerDegree;
+    _preferences.putFloat(PREF_TC_COEFF_KEY, _coefficient);
+    rebase();
+}
+
+float TempCompensator::getCoefficient() {
+    return _coefficient;
+}
+
+void TempCompensator::setBatchSteps(uint16_t steps) {
+    _batchSteps = max(steps, (uint16_t)1);
+    _preferences.putUShort(PREF_TC_BATCH_KEY, _batchSteps);
+}
+
+uint16_t TempCompensator::getBatchSteps() {
+    return _batchSteps;
+}
+
+void TempCompensator::setInterval(uint16_t seconds) {
+    _interval = seconds;
+    _preferences.putUShort(PREF_TC_INTERVAL_KEY, _interval);
+}
+
+uint16_t TempCompensator::getInterval() {
+    return _interval;
+}
+
+void TempCompensator::setMaxStep(uint16_t steps) {
+    _maxStep = max(steps, (uint16_t)1);
+    _preferences.putUShort(PREF_TC_MAXSTEP_KEY, _maxStep);
+}
+
+uint16_t TempCompensator::getMaxStep() {
+    return _maxStep;
+}
+
+// ============================================================================
+// Exposure Windows
+// ============================================================================
+
+void TempCompensator::holdFor(uint32_t durationMs, unsigned long now) {
+    _held = durationMs > 0;
+    _holdStart = now;
+    _holdDuration = durationMs;
+}
+
+void TempCompensator::releaseHold() {
+    _held = false;
+}
+
+bool TempCompensator::isHeld(unsigned long now) {
+    if (_held && now - _holdStart >= _holdDuration) {
+        _held = false;
+    }
+    return _held;
+}
+
+// ============================================================================
+// Scheduling
+// ============================================================================
+
+void TempCompensator::rebase() {
+    // Called whenever focus is set by hand: compensate relative to here
+    _hasReference = _hasSample;
+    _referenceTemperature = _temperature;
+    _appliedSteps = 0;
+    _suspendedDirection = 0;
+}
+
+int32_t TempCompensator::getPendingSteps() {
+    if (!_hasReference) {
+        return 0;
+    }
+    int32_t desired = lroundf((_temperature - _referenceTemperature) * _coefficient);
+    return desired - _appliedSteps;
+}
+
+bool TempCompensator::update(unsigned long now, int32_t &correction) {
+    // Caller only asks when the focuser is idle; returns a correction to apply
+    // and reports what was really moved through commitCorrection()
+    if (!_enabled || !hasTemperature(now) || isHeld(now)) {
+        return false;
+    }
+
+    if (_lastCorrection != 0 && now - _lastCorrection < (unsigned long)_interval * 1000) {
+        return false;
+    }
+
+    // Blocked at a limit until the drift turns back or focus is set by hand
+    int32_t pending = getPendingSteps();
+    if ((_suspendedDirection > 0 && pending > 0) || (_suspendedDirection < 0 && pending < 0)) {
+        return false;
+    }
+    _suspendedDirection = 0;
+
+    // Batch: wait until enough drift has accumulated
+    if (abs(pending) < _batchSteps) {
+        return false;
+    }
+
+    correction = constrain(pending, -(int32_t)_maxStep, (int32_t)_maxStep);
+    _lastCorrection = now;
+    return true;
+}
+
+void TempCompensator::commitCorrection(int32_t steps) {
+    // A failed or clamped move leaves the rest pending for the next interval
+    _appliedSteps += steps;
+}
+
+void TempCompensator::suspendCorrection(int32_t steps) {
+    // The focuser is already at the limit in this direction: the correction
+    // stays pending, but is not proposed again until the drift reverses
+    _suspendedDirection = (steps > 0) ? 1 : -1;
+}
+
+bool TempCompensator::isSuspended() {
+    return _suspendedDirection != 0;
+}
@@ -0,0 +1,108 @@
+/*
+    Temperature Compensation for ESP32 Celestron Focuser Controller
+    Steps-per-degree model applied as small, rate-limited correction moves
+
+    Copyright (C) 2024
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include <Preferences.h>
+
+// Preferences keys
+#define TEMPCOMP_PREF_NAMESPACE "focuser"
+#define PREF_TC_ENABLED_KEY "tc_enabled"
+#define PREF_TC_COEFF_KEY "tc_coeff"
+#define PREF_TC_BATCH_KEY "tc_batch"
+#define PREF_TC_INTERVAL_KEY "tc_interval"
+#define PREF_TC_MAXSTEP_KEY "tc_maxstep"
+
+// Default values
+#define TEMPCOMP_DEFAULT_COEFF 0.0f         // Steps per degree C
+#define TEMPCOMP_DEFAULT_BATCH 5            // Minimum correction in steps
+#define TEMPCOMP_DEFAULT_INTERVAL 60        // Minimum seconds between corrections
+#define TEMPCOMP_DEFAULT_MAXSTEP 50         // Largest single correction in steps
+
+// Sample handling
+#define TEMPCOMP_SMOOTHING 4                // EWMA weight for samples (1/N)
+#define TEMPCOMP_SAMPLE_TIMEOUT_MS 300000   // Stop correcting on samples older than this
+
+// Optional local DS18B20 sensor: build with -DTEMP_SENSOR_ONEWIRE_PIN=<gpio>
+// and the OneWire/DallasTemperature libraries (see platformio.ini)
+#define TEMP_SENSOR_INTERVAL_MS 10000       // Local sensor sample period
+#define TEMP_SENSOR_CONVERSION_MS 750       // DS18B20 12 bit conversion time
+
+/**
+ * Temperature Compensator Class
+ * Turns ambient temperature samples into batched focus corrections that
+ * are held back while the client has declared an exposure in progress
+ */
+class TempCompensator {
+public:
+    // Constructor
+    TempCompensator();
+
+    // Initialization
+    void begin();
+
+    // Temperature Samples
+    void addSample(float celsius, unsigned long now);
+    void pollSensor(unsigned long now);
+    bool hasTemperature(unsigned long now);
+    float getTemperature();
+
+    // Configuration
+    void setEnabled(bool enabled);
+    bool isEnabled();
+    void setCoefficient(float stepsPerDegree);
+    float getCoefficient();
+    void setBatchSteps(uint16_t steps);
+    uint16_t getBatchSteps();
+    void setInterval(uint16_t seconds);
+    uint16_t getInterval();
+    void setMaxStep(uint16_t steps);
+    uint16_t getMaxStep();
+
+    // Exposure Windows
+    void holdFor(uint32_t durationMs, unsigned long now);
+    void releaseHold();
+    bool isHeld(unsigned long now);
+
+    // Scheduling
+    void rebase();
+    bool update(unsigned long now, int32_t &correction);
+    void commitCorrection(int32_t steps);   // Steps actually commanded for the last correction
+    void suspendCorrection(int32_t steps);  // Correction blocked by a limit: not retried that way
+    bool isSuspended();
+    int32_t getPendingSteps();
+
+private:
+    Preferences _preferences;
+
+    // Configuration
+    bool _enabled;
+    float _coefficient;
+    uint16_t _batchSteps;
+    uint16_t _interval;
+    uint16_t _maxStep;
+
+    // Temperature
+    bool _hasSample;
+    float _temperature;
+    unsigned long _sampleTime;
+
+    // Compensation State
+    bool _hasReference;
+    float _referenceTemperature;
+    int32_t _appliedSteps;
+    unsigned long _lastCorrection;
+    int8_t _suspendedDirection;             // Sign of a correction blocked at a limit, 0 if none
+    bool _held;
+    unsigned long _holdStart;
+    uint32_t _holdDuration;
+
+    // Local Sensor
+    bool _conversionPending;
+    unsigned long _conversionStart;
+};
@@ -0,0 +1,29 @@
+/*
+    Embedded Web Assets for ESP32 Celestron Focuser Controller
+    Pre-gzipped files from data/, generated at build time by tools/embed_assets.py
+
+    Copyright (C) 2024
+*/
+
+#pragma once
+
+#include <Arduino.h>
+
+// Browsers revalidate with If-None-Match; unchanged assets cost a 304
+#define WEB_ASSET_CACHE_CONTROL "no-cache"
+
+/**
+ * Web Asset
+ * Gzipped content stays in flash and is sent without copying
+ */
+struct WebAsset {
+    const char* path;
+    const char* contentType;
+    const uint8_t* data;
+    size_t length;
+    const char* etag;           // Quoted strong ETag (content hash)
+};
+
+// Defined in the generated web_assets_data.cpp
+extern const WebAsset WEB_ASSETS[];
+extern const size_t WEB_ASSET_COUNT;
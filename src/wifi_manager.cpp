@@ -18,17 +18,41 @@ WiFiManager::WiFiManager() {
     _stationMode = false;
     _wifiConnected = false;
     _webServer = nullptr;
-    _webSocketServer = nullptr;
+    _webSocket = nullptr;
+    _events = nullptr;
+    _webEvents = nullptr;
+    _lifecycleEvents = nullptr;
     _hostname = DEFAULT_HOSTNAME;
+    _hasStatus = false;
+    _statusSeq = 0;
+    _statusLength = 0;
+    _samplePosition = 0;
+    _sampleMoving = false;
+    _sampleTime = 0;
+    memset(_clients, 0, sizeof(_clients));
+    memset(_positionFrame, 0, sizeof(_positionFrame));
+    memset(_operations, 0, sizeof(_operations));
+    for (uint8_t i = 0; i < REST_MAX_PENDING; i++) {
+        _pending[i].completion = nullptr;
+        _pending[i].tag = 0;
+        _pending[i].used = false;
+    }
+    _pendingLock = nullptr;
+    _commands = nullptr;
+    _modeChange = MODE_CHANGE_NONE;
+    _scheduler = nullptr;
+    _connecting = false;
+    _fallbackToAP = false;
+    _connectAttempt = 0;
+    _connectStart = 0;
+    _worker = nullptr;
 }
 
 WiFiManager::~WiFiManager() {
+    // The web server owns the WebSocket handler
     if (_webServer) {
         delete _webServer;
     }
-    if (_webSocketServer) {
-        delete _webSocketServer;
-    }
 }
 
 // ============================================================================
@@ -38,14 +62,6 @@ WiFiManager::~WiFiManager() {
 bool WiFiManager::begin() {
     Serial.println("INFO: Initializing WiFi Manager...");
     
-    // Initialize SPIFFS (optional)
-    if (!SPIFFS.begin(true)) {
-        Serial.println("WARNING: SPIFFS Mount Failed - using inline HTML fallback");
-        // Continue anyway, we have fallback HTML
-    } else {
-        Serial.println("INFO: SPIFFS initialized successfully");
-    }
-    
     // Initialize preferences
     _preferences.begin(PREF_NAMESPACE, false);
     
@@ -61,27 +77,43 @@ bool WiFiManager::begin() {
     // Register WiFi event handler
     WiFi.onEvent(std::bind(&WiFiManager::_onWiFiEvent, this, std::placeholders::_1));
     
-    // Try to connect to saved WiFi first
+    // Try to connect to saved WiFi first (falls back to AP mode if it times out)
     if (!_ssid.isEmpty()) {
         Serial.println("INFO: Attempting to connect to saved WiFi: " + _ssid);
+        _fallbackToAP = true;
         if (startStation()) {
+            // Serve from the start: the listener survives the switch to AP mode
+            setupWebServer();
             return true;
         }
+        _fallbackToAP = false;
     }
     
-    // If station mode fails, start AP mode
+    // No saved network: start AP mode
     Serial.println("INFO: Starting AP mode for WiFi configuration");
     return startAP();
 }
 
 void WiFiManager::handle() {
-    // Handle WebSocket connections
-    if (_webSocketServer) {
-        _webSocketServer->loop();
+    if (_webSocket) {
+        _webSocket->cleanupClients(WS_MAX_CLIENTS);
+    }
+    
+    // Switch modes once the reply to setWiFi/clearWiFi has gone out
+    if (_modeChange != MODE_CHANGE_NONE) {
+        ModeChange change = _modeChange;
+        _modeChange = MODE_CHANGE_NONE;
+        _scheduler->after(WIFI_MODE_CHANGE_DELAY, [this, change]() {
+            if (change == MODE_CHANGE_STATION) {
+                startStation();
+            } else {
+                startAP();
+            }
+        });
     }
     
     // Handle WiFi reconnection in station mode
-    if (_stationMode && !_wifiConnected && !_ssid.isEmpty()) {
+    if (_stationMode && !_wifiConnected && !_connecting && !_ssid.isEmpty()) {
         static unsigned long lastReconnectAttempt = 0;
         if (millis() - lastReconnectAttempt > WIFI_RECONNECT_DELAY) {
             Serial.println("INFO: Attempting to reconnect to WiFi...");
@@ -91,6 +123,22 @@ void WiFiManager::handle() {
     }
 }
 
+void WiFiManager::setScheduler(Scheduler *scheduler) {
+    _scheduler = scheduler;
+}
+
+void WiFiManager::processEvents() {
+    // Run WebSocket and REST commands queued by the TCP task
+    if (_webSocket) {
+        _processWebEvents();
+        _pumpClients();
+    }
+}
+
+void WiFiManager::setWorkerTask(TaskHandle_t task) {
+    _worker = task;
+}
+
 // ============================================================================
 // WiFi Control
 // ============================================================================
@@ -162,14 +210,22 @@ bool WiFiManager::connectToWiFi() {
     
     WiFi.begin(_ssid.c_str(), _password.c_str());
     
-    // Wait for connection
-    unsigned long startTime = millis();
-    while (WiFi.status() != WL_CONNECTED && (millis() - startTime) < (WIFI_CONNECT_TIMEOUT * 1000)) {
-        delay(500);
-        Serial.print(".");
+    // Poll for the connection from the scheduler instead of blocking here
+    uint32_t attempt = ++_connectAttempt;
+    _connecting = true;
+    _connectStart = millis();
+    return _scheduler->after(WIFI_CONNECT_POLL, [this, attempt]() { _checkConnection(attempt); });
+}
+
+void WiFiManager::_checkConnection(uint32_t attempt) {
+    // A newer attempt (mode change or reconnect) owns the connection now
+    if (attempt != _connectAttempt || _apMode) {
+        return;
     }
     
     if (WiFi.status() == WL_CONNECTED) {
+        _connecting = false;
+        _fallbackToAP = false;
         _wifiConnected = true;
         Serial.println("");
         Serial.println("SUCCESS: WiFi connected!");
@@ -180,20 +236,32 @@ bool WiFiManager::connectToWiFi() {
         // Setup web server
         setupWebServer();
         
-    // Start mDNS service
-    startmDNS();
+        // Start mDNS service
+        startmDNS();
+        
+        // Call connected callback
+        if (_onConnected) {
+            _onConnected();
+        }
+        return;
+    }
     
-    // Call connected callback
-    if (_onConnected) {
-        _onConnected();
+    if (millis() - _connectStart < (WIFI_CONNECT_TIMEOUT * 1000)) {
+        Serial.print(".");
+        _scheduler->after(WIFI_CONNECT_POLL, [this, attempt]() { _checkConnection(attempt); });
+        return;
     }
     
-    return true;
-    } else {
-        _wifiConnected = false;
-        Serial.println("");
-        Serial.println("ERROR: WiFi connection failed");
-        return false;
+    _connecting = false;
+    _wifiConnected = false;
+    Serial.println("");
+    Serial.println("ERROR: WiFi connection failed");
+    
+    // The saved network is unreachable at boot: make the device configurable
+    if (_fallbackToAP) {
+        _fallbackToAP = false;
+        Serial.println("INFO: Starting AP mode for WiFi configuration");
+        startAP();
     }
 }
 
@@ -280,113 +348,187 @@ String WiFiManager::getHostname() {
     return _hostname;
 }
 
+void WiFiManager::getWiFiStatus(JsonDocument &doc) {
+    // Built from fixed buffers so the document never needs a String
+    IPAddress address = _apMode ? WiFi.softAPIP() : WiFi.localIP();
+    char ip[16] = "";
+    if (_apMode || _wifiConnected) {
+        snprintf(ip, sizeof(ip), "%u.%u.%u.%u", address[0], address[1], address[2], address[3]);
+    }
+    
+    doc["status"] = "wifi";  // Add status field for JavaScript detection
+    // For web interface, "connected" means connected to external WiFi (not AP mode)
+    doc["connected"] = _wifiConnected && !_apMode;
+    doc["apMode"] = _apMode;
+    doc["ssid"] = _apMode ? WIFI_AP_SSID : _ssid.c_str();
+    doc["ip"] = ip;
+    doc["hostname"] = _hostname.c_str();
+    
+    if (_wifiConnected && !_apMode) {
+        doc["rssi"] = WiFi.RSSI();
+    }
+}
+
 // ============================================================================
 // Web Interface
 // ============================================================================
 
 void WiFiManager::setupWebServer() {
     if (_webServer) {
-        delete _webServer;
+        // Listener is bound to all interfaces and survives AP/station switches
+        Serial.println("INFO: Web server already running on port " + String(WEB_SERVER_PORT));
+        return;
     }
     
-    _webServer = new AsyncWebServer(WEB_SERVER_PORT);
-    _setupWebRoutes();
-    _webServer->begin();
+    _webEvents = xQueueCreate(WEB_EVENT_QUEUE_LENGTH, sizeof(WebEvent));
+    _lifecycleEvents = xQueueCreate(WEB_LIFECYCLE_QUEUE_LENGTH, sizeof(WebLifecycleEvent));
+    _pendingLock = xSemaphoreCreateMutex();
     
-    // Setup WebSocket server
-    if (_webSocketServer) {
-        delete _webSocketServer;
-    }
+    // WebSocket shares the web server's listener and connection handling
+    _webServer = new AsyncWebServer(WEB_SERVER_PORT);
+    _webSocket = new AsyncWebSocket(WEBSOCKET_PATH);
+    _webSocket->onEvent([this](AsyncWebSocket *server, AsyncWebSocketClient *client, AwsEventType type,
+                               void *arg, uint8_t *data, size_t length) {
+        _onWebEvent(client, type, arg, data, length);
+    });
+    _webServer->addHandler(_webSocket);
     
-    _webSocketServer = new WebSocketsServer(WEBSOCKET_PORT);
-    _webSocketServer->onEvent([](uint8_t num, WStype_t type, uint8_t * payload, size_t length) {
-        if (type == WStype_TEXT) {
-            wifiManager.handleWebSocketMessage(num, payload, length);
-        }
+    // Observe-only clients subscribe to the same status stream over SSE
+    _events = new AsyncEventSource(EVENTS_PATH);
+    _events->onConnect([this](AsyncEventSourceClient *client) {
+        _onEventsConnect(client);
     });
-    _webSocketServer->begin();
+    _webServer->addHandler(_events);
+    
+    _setupWebRoutes();
+    _webServer->begin();
     
     Serial.println("INFO: Web server started on port " + String(WEB_SERVER_PORT));
-    Serial.println("INFO: WebSocket server started on port " + String(WEBSOCKET_PORT));
+    Serial.println("INFO: WebSocket available at " + String(WEBSOCKET_PATH));
+    Serial.println("INFO: Event stream available at " + String(EVENTS_PATH));
 }
 
-void WiFiManager::handleWebSocketMessage(uint8_t num, uint8_t *payload, size_t length) {
-    String message = String((char*)payload, length);
+void WiFiManager::handleWebSocketMessage(uint32_t clientId, uint8_t *payload, size_t length) {
+    Serial.printf("INFO: WebSocket message: %.*s\n", (int)length, (const char*)payload);
     
-    Serial.println("INFO: WebSocket message: " + message);
-    
-    // Parse JSON message
-    JsonDocument doc;
-    DeserializationError error = deserializeJson(doc, message);
+    // Parse JSON message; documents live in the static loop arena
+    JsonDocument doc(&auxJsonArena);
+    DeserializationError error = deserializeJson(doc, (const char*)payload, length);
     
     if (error) {
-        Serial.println("ERROR: JSON parsing failed: " + String(error.c_str()));
+        Serial.printf("ERROR: JSON parsing failed: %s\n", error.c_str());
         return;
     }
     
-    String command = doc["command"];
+    if (!_commands) {
+        return;
+    }
     
-    if (command == "getStatus") {
-        String statusJson = _getWiFiStatusJSON();
-        _webSocketServer->sendTXT(num, statusJson);
+    // Request ids are echoed verbatim and kept for completion events
+    const char *command = doc["command"] | "";
+    JsonVariantConst id = doc["id"];
+    JsonDocument response(&auxJsonArena);
+    if (!id.isNull() && (!(id.is<const char*>() || id.is<double>()) || measureJson(id) >= WS_REQUEST_ID_SIZE)) {
+        response["status"] = "error";
+        response["command"] = command;
+        response["message"] = "invalid parameter";
+        response["param"] = "id";
+        _sendJson(clientId, response);
+        return;
     }
-    else if (command == "setWiFi") {
-        String ssid = doc["ssid"];
-        String password = doc["password"];
-        String hostname = doc["hostname"];
-        
-        if (!hostname.isEmpty()) {
-            saveHostname(hostname);
+    
+    // Handlers may add result fields to the response
+    CommandContext context = {SOURCE_WEBSOCKET, clientId};
+    const CommandDef *matched;
+    uint32_t started = micros();
+    CommandResult result = _commands->dispatch(command, context, doc, response, &matched);
+    _traceCommand(context, command, result, micros() - started);
+    
+    // Connection-level commands reply (or not) exactly as their handler built it
+    if (matched && (matched->flags & CMD_FLAG_RAW)) {
+        if (response.size() > 0) {
+            if (!id.isNull()) {
+                response["id"] = id;
+            }
+            _sendJson(clientId, response);
         }
-        
-        saveWiFiConfig(ssid, password);
-        
-        // Send response
-        JsonDocument response;
-        response["status"] = "success";
-        response["message"] = "WiFi configuration saved";
-        
-        String responseStr;
-        serializeJson(response, responseStr);
-        _webSocketServer->sendTXT(num, responseStr);
-        
-        // Restart in station mode
-        delay(1000);
-        startStation();
+        return;
     }
-    else if (command == "clearWiFi") {
-        clearWiFiConfig();
-        
-        // Send response
-        JsonDocument response;
-        response["status"] = "success";
-        response["message"] = "WiFi configuration cleared";
-        
-        String responseStr;
-        serializeJson(response, responseStr);
-        _webSocketServer->sendTXT(num, responseStr);
-        
-        // Restart in AP mode
-        delay(1000);
-        startAP();
+    
+    // Long-running commands that started are acked as accepted; blocking
+    // ones have already finished either way and report it as an event
+    uint8_t group = matched ? (matched->flags & CMD_FLAG_OPERATION) : 0;
+    bool accepted = group && (result == COMMAND_OK || (group == CMD_FLAG_BLOCKING && result == COMMAND_FAILED));
+    uint8_t ackStatus = accepted ? ACK_ACCEPTED : (result == COMMAND_OK) ? ACK_SUCCESS : ACK_ERROR;
+    
+    // Binary clients get a fixed-size ack; JSON only if there is data to return
+    bool sendJson = true;
+    if (_isBinaryClient(clientId)) {
+        uint8_t frame[FRAME_ACK_SIZE];
+        uint32_t hash = matched ? matched->hash : BinaryProtocol::commandHash(command);
+        BinaryProtocol::encodeAck(frame, ackStatus, hash, id | 0UL);
+        ClientSlot *slot = _findClient(clientId);
+        if (slot) {
+            _queueFrame(*slot, frame, sizeof(frame), true);
+        }
+        sendJson = (response.size() > 0);
     }
-    else if (command.startsWith("focuser:")) {
-        // Handle focuser commands
-        if (_focuserCallback) {
-            bool success = _focuserCallback(command, doc);
-            
-            // Send response
-            JsonDocument response;
-            response["status"] = success ? "success" : "error";
-            response["command"] = command;
-            
-            String responseStr;
-            serializeJson(response, responseStr);
-            _webSocketServer->sendTXT(num, responseStr);
+    
+    // Send response
+    if (sendJson) {
+        response["status"] = accepted ? "accepted" : (result == COMMAND_OK) ? "success" : "error";
+        response["command"] = command;
+        if (!id.isNull()) {
+            response["id"] = id;
+        }
+        _sendJson(clientId, response);
+    }
+    
+    if (accepted) {
+        _startOperation(clientId, *matched, id);
+        if (group == CMD_FLAG_BLOCKING) {
+            finishOperations(CMD_FLAG_BLOCKING, result == COMMAND_OK, nullptr, 0);
         }
     }
 }
 
+// ============================================================================
+// WiFi Commands
+// ============================================================================
+
+void WiFiManager::configureWiFi(const char* ssid, const char* password, const char* hostname) {
+    if (hostname[0] != '\0') {
+        saveHostname(hostname);
+    }
+    saveWiFiConfig(ssid, password);
+    
+    // Restart in station mode (loop() schedules the switch)
+    _modeChange = MODE_CHANGE_STATION;
+}
+
+void WiFiManager::resetWiFi() {
+    clearWiFiConfig();
+    
+    // Restart in AP mode
+    _modeChange = MODE_CHANGE_AP;
+}
+
+void WiFiManager::negotiateProtocol(uint32_t clientId, const char* protocol) {
+    if (!_webSocket) return;
+    
+    // Protocol negotiation; JSON stays the default
+    bool binary = (strcmp(protocol, BINARY_PROTOCOL_NAME) == 0);
+    _setBinaryClient(clientId, binary);
+    
+    JsonDocument response(&auxJsonArena);
+    response["type"] = "hello";
+    response["protocol"] = binary ? BINARY_PROTOCOL_NAME : "json";
+    response["version"] = BINARY_PROTOCOL_VERSION;
+    _sendJson(clientId, response);
+    
+    sendFocuserSnapshot(clientId);
+}
+
 // ============================================================================
 // mDNS Support
 // ============================================================================
@@ -406,7 +548,7 @@ bool WiFiManager::startmDNS() {
     
     // Add service for web server
     MDNS.addService("http", "tcp", WEB_SERVER_PORT);
-    MDNS.addService("ws", "tcp", WEBSOCKET_PORT);
+    MDNS.addService("ws", "tcp", WEB_SERVER_PORT);
     
     // Add service description
     MDNS.addServiceTxt("http", "tcp", "service", "celestron-focuser");
@@ -415,7 +557,7 @@ bool WiFiManager::startmDNS() {
     
     Serial.println("SUCCESS: mDNS service started");
     Serial.println("INFO: Access device at: http://" + _hostname + ".local");
-    Serial.println("INFO: WebSocket at: ws://" + _hostname + ".local:" + String(WEBSOCKET_PORT));
+    Serial.println("INFO: WebSocket at: ws://" + _hostname + ".local" + WEBSOCKET_PATH);
     
     return true;
 }
@@ -441,533 +583,571 @@ void WiFiManager::onWiFiDisconnected(std::function<void()> callback) {
     _onDisconnected = callback;
 }
 
-void WiFiManager::setFocuserCallback(std::function<bool(String, JsonDocument&)> callback) {
-    _focuserCallback = callback;
+void WiFiManager::setCommandRegistry(CommandRegistry *registry) {
+    _commands = registry;
 }
 
-void WiFiManager::sendFocuserStatus(uint8_t num, bool connected, uint32_t position, uint32_t target, uint8_t speed, bool moving) {
-    if (!_webSocketServer) return;
+void WiFiManager::broadcastFocuserStatus(const FocuserStatus& status) {
+    if (!_webSocket) return;
+    
+    // Nothing changed since the last push: every client is already current
+    if (_hasStatus && status == _lastStatus) {
+        return;
+    }
+    
+    // Serialize once into the reusable buffer: only the changed fields,
+    // or everything for the very first push
+    size_t length;
+    _statusSeq++;
+    if (_hasStatus) {
+        length = _formatDelta(status, _statusBuffer, sizeof(_statusBuffer));
+        _lastStatus = status;
+    } else {
+        _lastStatus = status;
+        _hasStatus = true;
+        length = _formatSnapshot(_statusBuffer, sizeof(_statusBuffer));
+    }
+    if (length == 0) {
+        return;
+    }
+    _statusLength = length;
     
-    JsonDocument doc;
-    doc["type"] = "focuserStatus";
-    doc["connected"] = connected;
-    doc["position"] = position;
-    doc["target"] = target;
-    doc["speed"] = speed;
-    doc["moving"] = moving;
+    // Refresh the snapshot SSE clients start from, then push the change
+    StatusSnapshot snapshot;
+    snapshot.length = _formatSnapshot(snapshot.text, sizeof(snapshot.text));
+    snapshot.seq = _statusSeq;
+    _snapshot.write(snapshot);
+    if (_events->count() > 0) {
+        _events->send(_statusBuffer, "status", _statusSeq);
+    }
     
-    String jsonString;
-    serializeJson(doc, jsonString);
-    _webSocketServer->sendTXT(num, jsonString);
+    // Status is superseded, not queued: a client that is still current gets
+    // this delta, one that missed a push gets a snapshot when it can take it
+    for (uint8_t slot = 0; slot < WS_MAX_CLIENTS; slot++) {
+        ClientSlot &client = _clients[slot];
+        if (client.id == 0 || !(client.topics & (1 << TOPIC_STATUS))) continue;
+        client.status = (client.status == STATUS_NONE && !client.binary) ? STATUS_DELTA : STATUS_SNAPSHOT;
+    }
 }
 
-// ============================================================================
-// Private Methods
-// ============================================================================
-
-void WiFiManager::_setupWebRoutes() {
-    // Root page
-    _webServer->on("/", HTTP_GET, [this](AsyncWebServerRequest *request) {
-        _handleRoot(request);
-    });
+void WiFiManager::broadcastPositionSample(uint32_t position, bool moving) {
+    if (!_webSocket) return;
     
-    // WiFi configuration endpoint
-    _webServer->on("/api/wifi", HTTP_POST, [this](AsyncWebServerRequest *request) {
-        _handleWiFiConfig(request);
-    });
+    // Only telemetry subscribers get samples; a sample still waiting (or
+    // held back by the client's rate) is replaced by the newer one
+    _samplePosition = position;
+    _sampleMoving = moving;
+    _sampleTime = millis();
+    BinaryProtocol::encodePosition(_positionFrame, position, moving, _sampleTime);
+    for (uint8_t slot = 0; slot < WS_MAX_CLIENTS; slot++) {
+        if (_clients[slot].id != 0 && (_clients[slot].topics & (1 << TOPIC_TELEMETRY))) {
+            _clients[slot].position = true;
+        }
+    }
+}
+
+void WiFiManager::broadcastMoveComplete(uint32_t position, uint32_t target) {
+    if (!_webSocket) return;
     
-    // Status endpoint
-    _webServer->on("/api/status", HTTP_GET, [this](AsyncWebServerRequest *request) {
-        _handleStatus(request);
-    });
+    char buffer[96];
+    int length = snprintf(buffer, sizeof(buffer), "{\"type\":\"moveComplete\",\"position\":%lu,\"target\":%lu}",
+                          (unsigned long)position, (unsigned long)target);
+    if (length <= 0 || length >= (int)sizeof(buffer)) {
+        return;
+    }
     
-    // 404 handler
-    _webServer->onNotFound([this](AsyncWebServerRequest *request) {
-        _handleNotFound(request);
-    });
+    if (_events->count() > 0) {
+        _events->send(buffer, "moveComplete");
+    }
+    _queueFrameAll((const uint8_t*)buffer, length, false);
 }
 
-void WiFiManager::_handleRoot(AsyncWebServerRequest *request) {
-    // Try to serve from SPIFFS first, fallback to inline HTML
-    if (SPIFFS.exists("/index.html")) {
-        request->send(SPIFFS, "/index.html", "text/html");
-    } else {
-        // Fallback inline HTML with focuser control interface
-        String html = R"rawliteral(<!DOCTYPE html>
-<html>
-<head>
-    <title>Celestron Focuser Controller</title>
-    <meta name="viewport" content="width=device-width, initial-scale=1">
-    <style>
-        body { font-family: 'Segoe UI', Tahoma, Geneva, Verdana, sans-serif; margin: 0; padding: 20px; background: linear-gradient(135deg, #667eea 0%, #764ba2 100%); min-height: 100vh; }
-        .container { max-width: 1200px; margin: 0 auto; }
-        .header { background: white; padding: 20px; border-radius: 15px; box-shadow: 0 4px 20px rgba(0,0,0,0.1); margin-bottom: 20px; text-align: center; }
-        .main-content { display: grid; grid-template-columns: 1fr 1fr; gap: 20px; }
-        .panel { background: white; padding: 25px; border-radius: 15px; box-shadow: 0 4px 20px rgba(0,0,0,0.1); }
-        .focuser-panel { grid-column: 1 / -1; }
-        h1 { color: #333; margin: 0; font-size: 2.5em; }
-        h2 { color: #555; margin-top: 0; border-bottom: 2px solid #eee; padding-bottom: 10px; }
-        .status { padding: 15px; margin: 15px 0; border-radius: 10px; font-weight: bold; }
-        .status.connected { background: linear-gradient(135deg, #d4edda, #c3e6cb); color: #155724; border: 1px solid #c3e6cb; }
-        .status.disconnected { background: linear-gradient(135deg, #f8d7da, #f5c6cb); color: #721c24; border: 1px solid #f5c6cb; }
-        .status.warning { background: linear-gradient(135deg, #fff3cd, #ffeaa7); color: #856404; border: 1px solid #ffeaa7; }
-        .form-group { margin: 20px 0; }
-        label { display: block; margin-bottom: 8px; font-weight: 600; color: #555; }
-        input[type="text"], input[type="password"], input[type="number"] { width: 100%; padding: 12px; border: 2px solid #ddd; border-radius: 8px; box-sizing: border-box; font-size: 16px; transition: border-color 0.3s; }
-        input[type="text"]:focus, input[type="password"]:focus, input[type="number"]:focus { outline: none; border-color: #667eea; }
-        button { background: linear-gradient(135deg, #667eea, #764ba2); color: white; padding: 12px 24px; border: none; border-radius: 8px; cursor: pointer; margin: 5px; font-size: 16px; font-weight: 600; transition: transform 0.2s, box-shadow 0.2s; }
-        button:hover { transform: translateY(-2px); box-shadow: 0 4px 15px rgba(102, 126, 234, 0.4); }
-        button:active { transform: translateY(0); }
-        button.danger { background: linear-gradient(135deg, #dc3545, #c82333); }
-        button.success { background: linear-gradient(135deg, #28a745, #20c997); }
-        button.warning { background: linear-gradient(135deg, #ffc107, #fd7e14); }
-        button.small { padding: 8px 16px; font-size: 14px; }
-        .buttons { text-align: center; margin: 20px 0; }
-        .info { background: linear-gradient(135deg, #d1ecf1, #bee5eb); color: #0c5460; padding: 15px; border-radius: 10px; margin: 15px 0; }
-        .focuser-controls { display: grid; grid-template-columns: repeat(auto-fit, minmax(200px, 1fr)); gap: 15px; margin: 20px 0; }
-        .position-display { background: linear-gradient(135deg, #f8f9fa, #e9ecef); padding: 20px; border-radius: 10px; text-align: center; margin: 15px 0; }
-        .position-value { font-size: 2em; font-weight: bold; color: #667eea; }
-        .speed-control { display: flex; align-items: center; gap: 10px; }
-        .speed-slider { flex: 1; }
-        .movement-controls { display: grid; grid-template-columns: 1fr 1fr; gap: 15px; margin: 20px 0; }
-        .movement-btn { padding: 20px; font-size: 18px; font-weight: bold; }
-        .step-controls { margin: 20px 0; }
-        .step-controls h3 { margin: 0 0 15px 0; color: #333; font-size: 16px; }
-        .step-buttons { display: flex; gap: 15px; flex-wrap: wrap; }
-        .step-group { display: flex; gap: 8px; }
-        .step-btn { padding: 12px 16px; font-size: 14px; font-weight: bold; border: 2px solid #007bff; background: white; color: #007bff; border-radius: 6px; cursor: pointer; transition: all 0.3s; }
-        .step-btn:hover { background: #007bff; color: white; }
-        .goto-controls { display: flex; gap: 10px; align-items: center; }
-        .goto-input { flex: 1; }
-        .status-indicators { display: flex; gap: 15px; margin: 15px 0; }
-        .status-indicator { flex: 1; padding: 10px; border-radius: 8px; text-align: center; font-weight: bold; }
-        .indicator-connected { background: #d4edda; color: #155724; }
-        .indicator-moving { background: #fff3cd; color: #856404; }
-        .indicator-disconnected { background: #f8d7da; color: #721c24; }
-        @media (max-width: 768px) {
-            .main-content { grid-template-columns: 1fr; }
-            .focuser-controls { grid-template-columns: 1fr; }
-            .movement-controls { grid-template-columns: 1fr; }
+void WiFiManager::finishOperations(uint8_t group, bool success, const char* message, uint32_t position) {
+    for (uint8_t i = 0; i < WS_MAX_OPERATIONS; i++) {
+        Operation &operation = _operations[i];
+        if (operation.clientId != 0 && operation.group == group) {
+            _sendOperationEvent(operation, success, message, position);
+            operation.clientId = 0;
         }
-    </style>
-</head>
-<body>
-    <div class="container">
-        <div class="header">
-            <h1>Celestron Focuser Controller</h1>
-            <div id="status" class="status disconnected">
-                <strong>Status:</strong> <span id="statusText">Disconnected</span>
-            </div>
-            <div id="info" class="info">
-                <strong>Device Info:</strong><br>
-                <span id="deviceInfo">Loading...</span>
-            </div>
-        </div>
-
-        <div class="main-content">
-            <!-- Focuser Control Panel -->
-            <div class="panel focuser-panel">
-                <h2>Focuser Control</h2>
-                
-                <div class="status-indicators">
-                    <div id="focuserStatus" class="status-indicator indicator-disconnected">
-                        Focuser: <span id="focuserStatusText">Disconnected</span>
-                    </div>
-                    <div id="movementStatus" class="status-indicator indicator-disconnected">
-                        Movement: <span id="movementStatusText">Stopped</span>
-                    </div>
-                </div>
-
-                <div class="position-display">
-                    <div>Current Position</div>
-                    <div id="currentPosition" class="position-value">---</div>
-                    <div>Target Position: <span id="targetPosition">---</span></div>
-                </div>
-
-                <div class="focuser-controls">
-                    <div class="form-group">
-                        <label for="focuserSpeed">Speed (1-9)</label>
-                        <div class="speed-control">
-                            <input type="range" id="focuserSpeed" class="speed-slider" min="1" max="9" value="5" onchange="updateSpeed()">
-                            <span id="speedValue">5</span>
-                        </div>
-                    </div>
-
-                    <div class="form-group">
-                        <label for="gotoPosition">Go to Position</label>
-                        <div class="goto-controls">
-                            <input type="number" id="gotoPosition" class="goto-input" placeholder="Enter position" min="0">
-                            <button onclick="gotoPosition()" class="success">Go</button>
-                        </div>
-                    </div>
-                </div>
-
-                <div class="movement-controls">
-                    <button id="moveInBtn" onclick="moveFocuser('in')" class="movement-btn success" disabled>
-                        Move IN
-                    </button>
-                    <button id="moveOutBtn" onclick="moveFocuser('out')" class="movement-btn success" disabled>
-                        Move OUT
-                    </button>
-                </div>
-
-                <div class="step-controls">
-                    <h3>Quick Steps</h3>
-                    <div class="step-buttons">
-                        <div class="step-group">
-                            <button onclick="stepFocuser('in', 5)" class="step-btn">+5</button>
-                            <button onclick="stepFocuser('out', 5)" class="step-btn">-5</button>
-                        </div>
-                        <div class="step-group">
-                            <button onclick="stepFocuser('in', 20)" class="step-btn">+20</button>
-                            <button onclick="stepFocuser('out', 20)" class="step-btn">-20</button>
-                        </div>
-                        <div class="step-group">
-                            <button onclick="stepFocuser('in', 50)" class="step-btn">+50</button>
-                            <button onclick="stepFocuser('out', 50)" class="step-btn">-50</button>
-                        </div>
-                    </div>
-                </div>
-
-                <div class="buttons">
-                    <button id="stopBtn" onclick="stopFocuser()" class="danger movement-btn" disabled>
-                        STOP
-                    </button>
-                    <button onclick="getPosition()" class="warning">
-                        Get Position
-                    </button>
-                    <button onclick="connectFocuser()" class="success">
-                        Connect Focuser
-                    </button>
-                </div>
-            </div>
-
-            <!-- WiFi Configuration Panel -->
-            <div class="panel">
-                <h2>WiFi Configuration</h2>
-                <form id="wifiForm">
-                    <div class="form-group">
-                        <label for="ssid">WiFi Network Name (SSID)</label>
-                        <input type="text" id="ssid" name="ssid" required>
-                    </div>
-                    
-                    <div class="form-group">
-                        <label for="password">WiFi Password</label>
-                        <input type="password" id="password" name="password">
-                    </div>
-                    
-                    <div class="form-group">
-                        <label for="hostname">Device Hostname</label>
-                        <input type="text" id="hostname" name="hostname" value="celestron-focuser">
-                    </div>
-                    
-                    <div class="buttons">
-                        <button type="submit">Save & Connect</button>
-                        <button type="button" onclick="clearConfig()" class="danger">Clear Config</button>
-                        <button type="button" onclick="refreshStatus()" class="warning">Refresh Status</button>
-                    </div>
-                </form>
-            </div>
-
-            <!-- System Info Panel -->
-            <div class="panel">
-                <h2>System Information</h2>
-                <div class="info">
-                    <strong>Connection Info:</strong><br>
-                    <span id="connectionInfo">Loading...</span>
-                </div>
-                <div class="buttons">
-                    <button onclick="showHelp()" class="warning">Help</button>
-                    <button onclick="showAbout()" class="success">About</button>
-                </div>
-            </div>
-        </div>
-    </div>
-
-    <script>
-        let ws;
-        let focuserConnected = false;
-        let currentPosition = 0;
-        let targetPosition = 0;
-        let currentSpeed = 5;
-        let isMoving = false;
-        
-        function connectWebSocket() {
-            const protocol = window.location.protocol === 'https:' ? 'wss:' : 'ws:';
-            const wsUrl = protocol + '//' + window.location.hostname + ':81';
-            
-            ws = new WebSocket(wsUrl);
-            
-            ws.onopen = function() {
-                console.log('WebSocket connected');
-                refreshStatus();
-                getPosition(); // Get initial position
-            };
-            
-            ws.onmessage = function(event) {
-                const data = JSON.parse(event.data);
-                console.log('Received:', data);
-                
-                if (data.type === 'focuserStatus') {
-                    updateFocuserStatus(data);
-                } else if (data.status === 'wifi') {
-                    updateStatus(data);
-                } else if (data.command && data.command.startsWith('focuser:')) {
-                    handleFocuserResponse(data);
-                }
-            };
-            
-            ws.onclose = function() {
-                console.log('WebSocket disconnected, retrying...');
-                setTimeout(connectWebSocket, 3000);
-            };
+    }
+}
+
+bool WiFiManager::hasTelemetryClients() {
+    for (uint8_t slot = 0; slot < WS_MAX_CLIENTS; slot++) {
+        if (_clients[slot].id != 0 && (_clients[slot].topics & (1 << TOPIC_TELEMETRY))) {
+            return true;
         }
-        
-        function updateStatus(data) {
-            const statusDiv = document.getElementById('status');
-            const statusText = document.getElementById('statusText');
-            const deviceInfo = document.getElementById('deviceInfo');
-            const connectionInfo = document.getElementById('connectionInfo');
-            
-            if (data.connected) {
-                statusDiv.className = 'status connected';
-                statusText.textContent = 'Connected to ' + data.ssid + ' (' + data.ip + ')';
-                deviceInfo.innerHTML = 'Hostname: ' + data.hostname + '<br>Signal: ' + data.rssi + ' dBm<br>mDNS: ' + data.hostname + '.local';
-                connectionInfo.innerHTML = 'WiFi: Connected<br>IP: ' + data.ip + '<br>mDNS: ' + data.hostname + '.local';
-            } else {
-                statusDiv.className = 'status disconnected';
-                statusText.textContent = 'Not connected (AP Mode)';
-                deviceInfo.innerHTML = 'AP SSID: ' + (data.ssid || 'Celestron-Focuser') + '<br>IP: ' + (data.ip || '192.168.4.1');
-                connectionInfo.innerHTML = 'WiFi: AP Mode<br>IP: ' + (data.ip || '192.168.4.1') + '<br>Connect to: ' + (data.ssid || 'Celestron-Focuser');
-            }
+    }
+    return false;
+}
+
+// ============================================================================
+// Topic Subscriptions
+// ============================================================================
+
+static const char* const TOPIC_NAMES[TOPIC_COUNT] = {"status", "wifi", "telemetry", "trace"};
+
+bool WiFiManager::subscribe(uint32_t clientId, JsonObjectConst topics, JsonDocument &response) {
+    ClientSlot *slot = _findClient(clientId);
+    if (!slot || clientId == 0) {
+        return false;
+    }
+    
+    // Check every name first so a bad request changes nothing
+    for (JsonPairConst topic : topics) {
+        bool known = false;
+        for (uint8_t i = 0; i < TOPIC_COUNT; i++) {
+            known = known || strcmp(topic.key().c_str(), TOPIC_NAMES[i]) == 0;
         }
-        
-        function updateFocuserStatus(data) {
-            focuserConnected = data.connected;
-            currentPosition = data.position;
-            targetPosition = data.target;
-            currentSpeed = data.speed;
-            isMoving = data.moving;
-            
-            // Update UI
-            document.getElementById('currentPosition').textContent = currentPosition.toLocaleString();
-            document.getElementById('targetPosition').textContent = targetPosition.toLocaleString();
-            document.getElementById('focuserSpeed').value = currentSpeed;
-            document.getElementById('speedValue').textContent = currentSpeed;
-            
-            // Update status indicators
-            const focuserStatus = document.getElementById('focuserStatus');
-            const focuserStatusText = document.getElementById('focuserStatusText');
-            const movementStatus = document.getElementById('movementStatus');
-            const movementStatusText = document.getElementById('movementStatusText');
-            
-            if (focuserConnected) {
-                focuserStatus.className = 'status-indicator indicator-connected';
-                focuserStatusText.textContent = 'Connected';
-                
-                // Enable/disable controls
-                document.getElementById('moveInBtn').disabled = isMoving;
-                document.getElementById('moveOutBtn').disabled = isMoving;
-                document.getElementById('stopBtn').disabled = !isMoving;
-                
-                if (isMoving) {
-                    movementStatus.className = 'status-indicator indicator-moving';
-                    movementStatusText.textContent = 'Moving';
-                } else {
-                    movementStatus.className = 'status-indicator indicator-connected';
-                    movementStatusText.textContent = 'Stopped';
-                }
-            } else {
-                focuserStatus.className = 'status-indicator indicator-disconnected';
-                focuserStatusText.textContent = 'Disconnected';
-                movementStatus.className = 'status-indicator indicator-disconnected';
-                movementStatusText.textContent = 'Unknown';
-                
-                // Disable all controls
-                document.getElementById('moveInBtn').disabled = true;
-                document.getElementById('moveOutBtn').disabled = true;
-                document.getElementById('stopBtn').disabled = true;
-            }
+        if (!known || !topic.value().is<float>() || topic.value().as<float>() < 0) {
+            response["message"] = "invalid parameter";
+            response["param"] = topic.key().c_str();
+            return false;
         }
-        
-        function handleFocuserResponse(data) {
-            if (data.status === 'success') {
-                console.log('Focuser command successful:', data.command);
-            } else {
-                console.error('Focuser command failed:', data.command);
-                alert('Focuser command failed: ' + data.command);
-            }
+    }
+    
+    for (uint8_t i = 0; i < TOPIC_COUNT; i++) {
+        JsonVariantConst value = topics[TOPIC_NAMES[i]];
+        if (value.isNull()) {
+            continue;
         }
         
-        function updateSpeed() {
-            currentSpeed = parseInt(document.getElementById('focuserSpeed').value);
-            document.getElementById('speedValue').textContent = currentSpeed;
-            
-            if (ws && ws.readyState === WebSocket.OPEN) {
-                ws.send(JSON.stringify({
-                    command: 'focuser:setSpeed',
-                    speed: currentSpeed
-                }));
-            }
+        float rate = value.as<float>();
+        uint8_t bit = 1 << i;
+        if (rate <= 0) {
+            slot->topics &= ~bit;
+            continue;
         }
         
-        function moveFocuser(direction) {
-            if (!focuserConnected) {
-                alert('Focuser not connected!');
-                return;
-            }
-            
-            if (ws && ws.readyState === WebSocket.OPEN) {
-                ws.send(JSON.stringify({
-                    command: 'focuser:move',
-                    direction: direction,
-                    speed: currentSpeed
-                }));
-            }
+        uint32_t interval = (rate >= TOPIC_MAX_RATE) ? 0 : (uint32_t)(1000 / rate);
+        if (i == TOPIC_WIFI) {
+            interval = max(interval, (uint32_t)TOPIC_WIFI_MIN_INTERVAL);
         }
+        slot->interval[i] = min(interval, (uint32_t)UINT16_MAX);
         
-        function stepFocuser(direction, steps) {
-            if (!focuserConnected) {
-                alert('Focuser not connected!');
-                return;
-            }
-            
-            if (ws && ws.readyState === WebSocket.OPEN) {
-                ws.send(JSON.stringify({
-                    command: 'focuser:step',
-                    direction: direction,
-                    steps: steps,
-                    speed: currentSpeed
-                }));
+        // Status resumes from a snapshot since deltas were skipped meanwhile
+        if (!(slot->topics & bit)) {
+            slot->topics |= bit;
+            slot->lastPush[i] = millis() - slot->interval[i];
+            if (i == TOPIC_STATUS && _hasStatus) {
+                slot->status = STATUS_SNAPSHOT;
             }
         }
-        
-        function stopFocuser() {
-            if (ws && ws.readyState === WebSocket.OPEN) {
-                ws.send(JSON.stringify({
-                    command: 'focuser:stop'
-                }));
-            }
+    }
+    
+    // Reply with the effective subscriptions as minimum intervals in ms
+    response["type"] = "subscribed";
+    JsonObject active = response["topics"].to<JsonObject>();
+    for (uint8_t i = 0; i < TOPIC_COUNT; i++) {
+        if (slot->topics & (1 << i)) {
+            active[TOPIC_NAMES[i]] = slot->interval[i];
         }
-        
-        function gotoPosition() {
-            const position = parseInt(document.getElementById('gotoPosition').value);
-            if (isNaN(position) || position < 0) {
-                alert('Please enter a valid position number');
-                return;
-            }
-            
-            if (!focuserConnected) {
-                alert('Focuser not connected!');
-                return;
+    }
+    return true;
+}
+
+void WiFiManager::sendFocuserSnapshot(uint32_t clientId) {
+    if (!_webSocket || !_hasStatus) return;
+    
+    // Full status tagged with the current sequence; deltas continue from it
+    ClientSlot *slot = _findClient(clientId);
+    if (slot && clientId != 0) {
+        slot->status = STATUS_SNAPSHOT;
+    }
+}
+
+// ============================================================================
+// Private Methods
+// ============================================================================
+
+void WiFiManager::_onWebEvent(AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t length) {
+    // Runs on the TCP task: copy the event into the queue and return
+    WebEvent event;
+    event.clientId = client->id();
+    event.length = 0;
+    
+    if (type == WS_EVT_CONNECT || type == WS_EVT_DISCONNECT) {
+        // Connects and disconnects have their own queue and are never dropped for messages
+        WebLifecycleEvent lifecycle;
+        lifecycle.type = (type == WS_EVT_CONNECT) ? WebEvent::CONNECT : WebEvent::DISCONNECT;
+        lifecycle.clientId = event.clientId;
+        if (xQueueSend(_lifecycleEvents, &lifecycle, 0) != pdTRUE) {
+            Serial.println("ERROR: WebSocket lifecycle queue full");
+        } else if (_worker) {
+            xTaskNotifyGive(_worker);
+        }
+        return;
+    }
+    else if (type == WS_EVT_DATA) {
+        // Commands are small: accept complete single-frame text messages only
+        AwsFrameInfo *info = (AwsFrameInfo*)arg;
+        if (!info->final || info->index != 0 || info->len != length || info->opcode != WS_TEXT) {
+            return;
+        }
+        if (length > WEB_MESSAGE_MAX_LEN) {
+            Serial.println("ERROR: WebSocket message too long: " + String(length));
+            return;
+        }
+        event.type = WebEvent::MESSAGE;
+        event.length = length;
+        memcpy(event.payload, data, length);
+    }
+    else {
+        return;
+    }
+    
+    if (xQueueSend(_webEvents, &event, 0) != pdTRUE) {
+        _rejectMessage(client, data, length);
+    } else if (_worker) {
+        xTaskNotifyGive(_worker);
+    }
+}
+
+void WiFiManager::_rejectMessage(AsyncWebSocketClient *client, const uint8_t *data, size_t length) {
+    // Runs on the TCP task: the command never reaches the AUX task, so tell
+    // the client here with the same error reply shape it would have got
+    Serial.println("ERROR: WebSocket event queue full");
+    JsonDocument request(&tcpJsonArena);
+    JsonDocument reply(&tcpJsonArena);
+    if (!deserializeJson(request, (const char*)data, length)) {
+        reply["command"] = request["command"];
+        if (!request["id"].isNull()) {
+            reply["id"] = request["id"];
+        }
+    }
+    reply["status"] = "error";
+    reply["message"] = "busy";
+    
+    char buffer[128];
+    size_t written = serializeJson(reply, buffer, sizeof(buffer));
+    if (written > 0 && written < sizeof(buffer)) {
+        client->text(buffer, written);
+    }
+}
+
+void WiFiManager::_processWebEvents() {
+    // Connects first: a new client's messages are queued after its connect
+    WebLifecycleEvent lifecycle;
+    while (xQueueReceive(_lifecycleEvents, &lifecycle, 0) == pdTRUE) {
+        if (lifecycle.type == WebEvent::CONNECT) {
+            // New clients speak JSON until they negotiate otherwise
+            ClientSlot *slot = _findClient(0);
+            if (slot) {
+                memset(slot, 0, sizeof(ClientSlot));
+                slot->id = lifecycle.clientId;
+                slot->topics = 1 << TOPIC_STATUS;
             }
             
-            if (ws && ws.readyState === WebSocket.OPEN) {
-                ws.send(JSON.stringify({
-                    command: 'focuser:goto',
-                    position: position
-                }));
-            }
-        }
-        
-        function getPosition() {
-            if (ws && ws.readyState === WebSocket.OPEN) {
-                ws.send(JSON.stringify({
-                    command: 'focuser:getPosition'
-                }));
+            // New clients start from a snapshot instead of waiting for a change
+            sendFocuserSnapshot(lifecycle.clientId);
+        } else {
+            _setBinaryClient(lifecycle.clientId, false);
+            ClientSlot *slot = _findClient(lifecycle.clientId);
+            if (slot) {
+                slot->id = 0;
             }
         }
-        
-        function connectFocuser() {
-            if (ws && ws.readyState === WebSocket.OPEN) {
-                // Show loading state
-                const btn = event.target;
-                const originalText = btn.textContent;
-                btn.textContent = 'Connecting...';
-                btn.disabled = true;
-                
-                ws.send(JSON.stringify({
-                    command: 'focuser:connect'
-                }));
+    }
+    
+    WebEvent event;
+    while (xQueueReceive(_webEvents, &event, 0) == pdTRUE) {
+        switch (event.type) {
+            case WebEvent::MESSAGE:
+                handleWebSocketMessage(event.clientId, (uint8_t*)event.payload, event.length);
+                break;
                 
-                // Reset button after a delay
-                setTimeout(() => {
-                    btn.textContent = originalText;
-                    btn.disabled = false;
-                }, 3000);
-            }
+            case WebEvent::HTTP_REQUEST:
+                _completeFocuserRequest(event);
+                break;
         }
-        
-        function refreshStatus() {
-            if (ws && ws.readyState === WebSocket.OPEN) {
-                ws.send(JSON.stringify({command: 'getStatus'}));
-            }
+    }
+}
+
+void WiFiManager::_onEventsConnect(AsyncEventSourceClient *client) {
+    // Runs on the TCP task: only the published snapshot copy is read
+    StatusSnapshot snapshot = _snapshot.read();
+    
+    if (snapshot.length > 0) {
+        snapshot.text[snapshot.length] = '\0';
+        client->send(snapshot.text, "status", snapshot.seq);
+    }
+}
+
+WiFiManager::ClientSlot* WiFiManager::_findClient(uint32_t clientId) {
+    // Client ids start at 1, so an id of 0 finds a free slot
+    for (uint8_t slot = 0; slot < WS_MAX_CLIENTS; slot++) {
+        if (_clients[slot].id == clientId) {
+            return &_clients[slot];
         }
-        
-        function clearConfig() {
-            if (confirm('Are you sure you want to clear the WiFi configuration?')) {
-                if (ws && ws.readyState === WebSocket.OPEN) {
-                    ws.send(JSON.stringify({command: 'clearWiFi'}));
-                }
-            }
+    }
+    return nullptr;
+}
+
+void WiFiManager::_setBinaryClient(uint32_t clientId, bool binary) {
+    ClientSlot *slot = _findClient(clientId);
+    if (!slot || clientId == 0 || slot->binary == binary) {
+        return;
+    }
+    slot->binary = binary;
+    
+    // Binary clients negotiate for the high-rate telemetry
+    if (binary) {
+        slot->topics |= 1 << TOPIC_TELEMETRY;
+    }
+}
+
+bool WiFiManager::_isBinaryClient(uint32_t clientId) {
+    ClientSlot *slot = _findClient(clientId);
+    return slot && clientId != 0 && slot->binary;
+}
+
+size_t WiFiManager::_formatSnapshot(char* buffer, size_t size) {
+    // Fault names are static identifiers and never need escaping
+    int length = snprintf(buffer, size,
+                          "{\"type\":\"focuserStatus\",\"seq\":%lu,\"connected\":%s,\"position\":%lu,"
+                          "\"target\":%lu,\"speed\":%u,\"moving\":%s,\"fault\":\"%s\"}",
+                          (unsigned long)_statusSeq,
+                          _lastStatus.connected ? "true" : "false",
+                          (unsigned long)_lastStatus.position, (unsigned long)_lastStatus.target,
+                          (unsigned)_lastStatus.speed, _lastStatus.moving ? "true" : "false",
+                          _lastStatus.fault);
+    return (length > 0 && length < (int)size) ? length : 0;
+}
+
+size_t WiFiManager::_formatDelta(const FocuserStatus& status, char* buffer, size_t size) {
+    // Compare against the previous push; caller updates _lastStatus afterwards
+    int length = snprintf(buffer, size, "{\"type\":\"focuserDelta\",\"seq\":%lu", (unsigned long)_statusSeq);
+    
+    if (status.connected != _lastStatus.connected) {
+        length += snprintf(buffer + length, size - length, ",\"connected\":%s", status.connected ? "true" : "false");
+    }
+    if (status.position != _lastStatus.position) {
+        length += snprintf(buffer + length, size - length, ",\"position\":%lu", (unsigned long)status.position);
+    }
+    if (status.target != _lastStatus.target) {
+        length += snprintf(buffer + length, size - length, ",\"target\":%lu", (unsigned long)status.target);
+    }
+    if (status.speed != _lastStatus.speed) {
+        length += snprintf(buffer + length, size - length, ",\"speed\":%u", (unsigned)status.speed);
+    }
+    if (status.moving != _lastStatus.moving) {
+        length += snprintf(buffer + length, size - length, ",\"moving\":%s", status.moving ? "true" : "false");
+    }
+    if (status.faultCode != _lastStatus.faultCode) {
+        length += snprintf(buffer + length, size - length, ",\"fault\":\"%s\"", status.fault);
+    }
+    length += snprintf(buffer + length, size - length, "}");
+    
+    return (length > 0 && length < (int)size) ? length : 0;
+}
+
+void WiFiManager::_setupWebRoutes() {
+    // Embedded web assets; the root page is index.html
+    for (size_t i = 0; i < WEB_ASSET_COUNT; i++) {
+        const WebAsset *asset = &WEB_ASSETS[i];
+        _webServer->on(asset->path, HTTP_GET, [this, asset](AsyncWebServerRequest *request) {
+            _handleAsset(request, *asset);
+        });
+        if (strcmp(asset->path, "/index.html") == 0) {
+            _webServer->on("/", HTTP_GET, [this, asset](AsyncWebServerRequest *request) {
+                _handleAsset(request, *asset);
+            });
         }
-        
-        function showHelp() {
-            alert('Focuser Control Help:\n\n' +
-                  '• Use the speed slider to set movement speed (1-9)\n' +
-                  '• Click Move IN/OUT for continuous movement\n' +
-                  '• Use Go to Position for precise positioning\n' +
-                  '• Click STOP to immediately stop movement\n' +
-                  '• Get Position updates the current position display\n\n' +
-                  'Make sure the focuser is connected before controlling!');
+    }
+    
+    // Focuser REST API
+    _setupFocuserRoutes();
+    
+    // WiFi configuration endpoint
+    _webServer->on("/api/wifi", HTTP_POST, [this](AsyncWebServerRequest *request) {
+        _handleWiFiConfig(request);
+    });
+    
+    // Status endpoint
+    _webServer->on("/api/status", HTTP_GET, [this](AsyncWebServerRequest *request) {
+        _handleStatus(request);
+    });
+    
+    // 404 handler
+    _webServer->onNotFound([this](AsyncWebServerRequest *request) {
+        _handleNotFound(request);
+    });
+}
+
+void WiFiManager::_handleAsset(AsyncWebServerRequest *request, const WebAsset &asset) {
+    // Cached copy is still current: headers only
+    if (request->hasHeader("If-None-Match") && request->header("If-None-Match") == asset.etag) {
+        AsyncWebServerResponse *response = request->beginResponse(304);
+        response->addHeader("ETag", asset.etag);
+        response->addHeader("Cache-Control", WEB_ASSET_CACHE_CONTROL);
+        request->send(response);
+        return;
+    }
+    
+    // Gzipped bytes are streamed straight from flash
+    AsyncWebServerResponse *response = request->beginResponse(200, asset.contentType, asset.data, asset.length);
+    response->addHeader("Content-Encoding", "gzip");
+    response->addHeader("ETag", asset.etag);
+    response->addHeader("Cache-Control", WEB_ASSET_CACHE_CONTROL);
+    request->send(response);
+}
+
+// ============================================================================
+// Focuser REST API
+// ============================================================================
+
+// More specific paths first: a route also matches "<path>/..."
+static const RestRoute REST_ROUTES[] = {
+    {"/api/focuser/position",       HTTP_GET,    "focuser:status",       {nullptr}},
+    {"/api/focuser/goto",           HTTP_POST,   "focuser:goto",         {"position", "speed", nullptr}},
+    {"/api/focuser/step",           HTTP_POST,   "focuser:step",         {"direction", "steps", "speed", nullptr}},
+    {"/api/focuser/move",           HTTP_POST,   "focuser:move",         {"direction", "speed", nullptr}},
+    {"/api/focuser/stop",           HTTP_POST,   "focuser:stop",         {nullptr}},
+    {"/api/focuser/speed",          HTTP_GET,    "focuser:status",       {nullptr}},
+    {"/api/focuser/speed",          HTTP_POST,   "focuser:setSpeed",     {"speed", nullptr}},
+    {"/api/focuser/presets/recall", HTTP_POST,   "focuser:recallPreset", {"name", nullptr}},
+    {"/api/focuser/presets",        HTTP_GET,    "focuser:listPresets",  {nullptr}},
+    {"/api/focuser/presets",        HTTP_POST,   "focuser:savePreset",   {"name", "position", "approach", "speed", nullptr}},
+    {"/api/focuser/presets",        HTTP_DELETE, "focuser:deletePreset", {"name", nullptr}},
+    {"/api/focuser/limits",         HTTP_GET,    "focuser:getLimits",    {nullptr}},
+    {"/api/focuser/limits",         HTTP_POST,   "focuser:setLimits",    {"min", "max", nullptr}},
+};
+
+static bool isNumeric(const String &value) {
+    if (value.length() == 0) return false;
+    size_t start = (value[0] == '-') ? 1 : 0;
+    bool digits = false;
+    for (size_t i = start; i < value.length(); i++) {
+        if (isdigit(value[i])) {
+            digits = true;
+        } else if (value[i] != '.') {
+            return false;
         }
-        
-        function showAbout() {
-            alert('Celestron Focuser Controller v1.0\n\n' +
-                  'ESP32-based WiFi focuser controller\n' +
-                  'with mDNS support and web interface.\n\n' +
-                  'Features:\n' +
-                  '• Real-time position tracking\n' +
-                  '• Speed control (1-9)\n' +
-                  '• Absolute positioning\n' +
-                  '• WiFi configuration\n' +
-                  '• mDNS device discovery');
+    }
+    return digits;
+}
+
+void WiFiManager::_setupFocuserRoutes() {
+    for (size_t i = 0; i < sizeof(REST_ROUTES) / sizeof(REST_ROUTES[0]); i++) {
+        const RestRoute *route = &REST_ROUTES[i];
+        _webServer->on(route->path, route->method, [this, route](AsyncWebServerRequest *request) {
+            _handleFocuserRequest(request, *route);
+        });
+    }
+}
+
+void WiFiManager::_handleFocuserRequest(AsyncWebServerRequest *request, const RestRoute &route) {
+    // Runs on the TCP task: turn the request into a command message for the AUX task
+    JsonDocument doc(&tcpJsonArena);
+    doc["command"] = route.command;
+    for (uint8_t i = 0; i < REST_MAX_PARAMS && route.params[i]; i++) {
+        const char *name = route.params[i];
+        const AsyncWebParameter *param = request->getParam(name);
+        if (!param) {
+            param = request->getParam(name, true);  // Form-encoded body
         }
+        if (!param) continue;
         
-        document.getElementById('wifiForm').addEventListener('submit', function(e) {
-            e.preventDefault();
-            
-            const formData = {
-                command: 'setWiFi',
-                ssid: document.getElementById('ssid').value,
-                password: document.getElementById('password').value,
-                hostname: document.getElementById('hostname').value
-            };
-            
-            if (ws && ws.readyState === WebSocket.OPEN) {
-                ws.send(JSON.stringify(formData));
-                alert('WiFi configuration saved! The device will restart and attempt to connect.');
+        const String &value = param->value();
+        if (!isNumeric(value)) {
+            doc[name] = value.c_str();
+        } else if (value.indexOf('.') >= 0) {
+            doc[name] = value.toFloat();
+        } else {
+            doc[name] = value.toInt();
+        }
+    }
+    
+    int error = deferRequest(request, doc, _sendRestResponse, 0);
+    if (error == 413) {
+        request->send(413, "application/json", "{\"status\":\"error\",\"message\":\"request too large\"}");
+    } else if (error != 0) {
+        request->send(error, "application/json", "{\"status\":\"error\",\"message\":\"busy\"}");
+    }
+}
+
+void WiFiManager::_sendRestResponse(AsyncWebServerRequest *request, JsonDocument &command, CommandResult result,
+                                    JsonDocument &response, uint32_t tag) {
+    response["status"] = (result == COMMAND_OK) ? "success" : "error";
+    response["command"] = command["command"];
+    
+    // Compact JSON streamed straight into the response buffer
+    AsyncResponseStream *stream = request->beginResponseStream("application/json");
+    stream->setCode((result == COMMAND_OK) ? 200 : (result == COMMAND_UNKNOWN) ? 404 : 400);
+    serializeJson(response, *stream);
+    request->send(stream);
+}
+
+AsyncWebServer* WiFiManager::getWebServer() {
+    return _webServer;
+}
+
+int WiFiManager::deferRequest(AsyncWebServerRequest *request, const JsonDocument &command,
+                              DeferredCompletion completion, uint32_t tag) {
+    // Runs on the TCP task: the command message goes to the AUX task by value
+    WebEvent event;
+    event.type = WebEvent::HTTP_REQUEST;
+    event.length = serializeJson(command, event.payload, sizeof(event.payload));
+    if (event.length == 0 || event.length >= sizeof(event.payload)) {
+        return 413;
+    }
+    
+    // Reserve a pending slot; this task is the only producer, so a free
+    // queue entry checked here is still free when we send
+    int slot = -1;
+    if (_webEvents && uxQueueSpacesAvailable(_webEvents) > 0) {
+        xSemaphoreTake(_pendingLock, portMAX_DELAY);
+        for (uint8_t i = 0; i < REST_MAX_PENDING; i++) {
+            if (!_pending[i].used) {
+                _pending[i].used = true;
+                slot = i;
+                break;
             }
-        });
-        
-        // Connect WebSocket when page loads
-        window.addEventListener('load', function() {
-            connectWebSocket();
-            refreshStatus();
-            
-            // Auto-refresh focuser status every 2 seconds
-            setInterval(function() {
-                if (focuserConnected) {
-                    getPosition();
-                }
-            }, 2000);
-        });
-    </script>
-</body>
-</html>)rawliteral";
-        
-        request->send(200, "text/html", html);
+        }
+        xSemaphoreGive(_pendingLock);
+    }
+    if (slot < 0) {
+        return 503;
+    }
+    
+    _pending[slot].request = request->pause();
+    _pending[slot].completion = completion;
+    _pending[slot].tag = tag;
+    event.clientId = slot;
+    xQueueSend(_webEvents, &event, 0);
+    if (_worker) {
+        xTaskNotifyGive(_worker);
     }
+    return 0;
+}
+
+void WiFiManager::_completeFocuserRequest(const WebEvent &event) {
+    // Runs on the AUX task: execute exactly like a WebSocket command
+    JsonDocument doc(&auxJsonArena);
+    deserializeJson(doc, event.payload, event.length);
+    const char *command = doc["command"] | "";
+    CommandContext context = {SOURCE_REST, 0};
+    
+    JsonDocument response(&auxJsonArena);
+    uint32_t started = micros();
+    CommandResult result = _commands ? _commands->dispatch(command, context, doc, response) : COMMAND_UNKNOWN;
+    _traceCommand(context, command, result, micros() - started);
+    
+    xSemaphoreTake(_pendingLock, portMAX_DELAY);
+    PendingRequest &slot = _pending[event.clientId];
+    AsyncWebServerRequestPtr pending = slot.request;
+    DeferredCompletion completion = slot.completion;
+    uint32_t tag = slot.tag;
+    slot.request = AsyncWebServerRequestPtr();
+    slot.used = false;
+    xSemaphoreGive(_pendingLock);
+    
+    // Client may have disconnected while the command ran
+    auto request = pending.lock();
+    if (!request || !completion) {
+        return;
+    }
+    completion(request.get(), doc, result, response, tag);
 }
 
 void WiFiManager::_handleWiFiConfig(AsyncWebServerRequest *request) {
@@ -976,42 +1156,270 @@ void WiFiManager::_handleWiFiConfig(AsyncWebServerRequest *request) {
 }
 
 void WiFiManager::_handleStatus(AsyncWebServerRequest *request) {
-    String statusJson = _getWiFiStatusJSON();
-    request->send(200, "application/json", statusJson);
+    // Runs on the TCP task, so it has its own arena
+    JsonDocument doc(&tcpJsonArena);
+    getWiFiStatus(doc);
+    
+    AsyncResponseStream *stream = request->beginResponseStream("application/json");
+    serializeJson(doc, *stream);
+    request->send(stream);
 }
 
 void WiFiManager::_handleNotFound(AsyncWebServerRequest *request) {
     request->send(404, "text/plain", "Not Found");
 }
 
-String WiFiManager::_getWiFiStatusJSON() {
-    JsonDocument doc;
+void WiFiManager::_sendJson(uint32_t clientId, const JsonDocument &doc) {
+    ClientSlot *slot = _findClient(clientId);
+    if (!slot || clientId == 0) {
+        return;
+    }
     
-    // Get values first
-    String ssid = getSSID();
-    String ip = getIPAddress();
+    // Serialize into the reusable buffer; the client queue keeps its own copy
+    size_t length = measureJson(doc);
+    if (length >= sizeof(_sendBuffer)) {
+        Serial.printf("ERROR: WebSocket response too large: %u\n", (unsigned)length);
+        return;
+    }
+    length = serializeJson(doc, _sendBuffer, sizeof(_sendBuffer));
+    _queueFrame(*slot, (const uint8_t*)_sendBuffer, length, false);
+}
+
+void WiFiManager::_startOperation(uint32_t clientId, const CommandDef &command, JsonVariantConst id) {
+    for (uint8_t i = 0; i < WS_MAX_OPERATIONS; i++) {
+        Operation &operation = _operations[i];
+        if (operation.clientId == 0) {
+            operation.clientId = clientId;
+            operation.group = command.flags & CMD_FLAG_OPERATION;
+            operation.command = &command;
+            operation.id[0] = '\0';
+            if (!id.isNull()) {
+                serializeJson(id, operation.id, sizeof(operation.id));
+            }
+            operation.binaryId = id | 0UL;
+            return;
+        }
+    }
     
-    doc["status"] = "wifi";  // Add status field for JavaScript detection
-    // For web interface, "connected" means connected to external WiFi (not AP mode)
-    doc["connected"] = _wifiConnected && !_apMode;
-    doc["apMode"] = _apMode;
-    doc["ssid"] = ssid;
-    doc["ip"] = ip;
-    doc["hostname"] = _hostname;
+    // Older operations are superseded as new ones start, so this is rare
+    Operation overflow = {clientId, 0, &command, "", id | 0UL};
+    if (!id.isNull()) {
+        serializeJson(id, overflow.id, sizeof(overflow.id));
+    }
+    _sendOperationEvent(overflow, false, "too many operations", 0);
+}
+
+void WiFiManager::_sendOperationEvent(const Operation &operation, bool success, const char* message, uint32_t position) {
+    ClientSlot *slot = _findClient(operation.clientId);
+    if (!slot) {
+        return;
+    }
     
-    if (_wifiConnected && !_apMode) {
-        doc["rssi"] = WiFi.RSSI();
+    if (slot->binary) {
+        uint8_t frame[FRAME_ACK_SIZE];
+        BinaryProtocol::encodeAck(frame, success ? ACK_SUCCESS : ACK_ERROR, operation.command->hash, operation.binaryId);
+        _queueFrame(*slot, frame, sizeof(frame), true);
+        return;
     }
     
-    String jsonString;
-    serializeJson(doc, jsonString);
+    JsonDocument event(&auxJsonArena);
+    event["type"] = success ? "completed" : "failed";
+    event["command"] = operation.command->name;
+    if (operation.id[0]) {
+        event["id"] = serialized(operation.id);
+    }
+    if (operation.group != CMD_FLAG_BLOCKING) {
+        event["position"] = position;
+    }
+    if (message) {
+        event["message"] = message;
+    }
+    _sendJson(operation.clientId, event);
+}
+
+void WiFiManager::_traceCommand(const CommandContext &context, const char* command, CommandResult result, uint32_t elapsed) {
+    static const char* const SOURCES[] = {"websocket", "rest", "serial"};
+    static const char* const RESULTS[] = {"ok", "failed", "unknown", "invalid"};
     
-    // Debug output (can be removed later)
-    // Serial.println("DEBUG: WiFi Status JSON: " + jsonString);
+    // Built only if someone is listening; rate-limited lines are counted
+    JsonDocument trace(&auxJsonArena);
+    unsigned long now = millis();
+    for (uint8_t i = 0; i < WS_MAX_CLIENTS; i++) {
+        ClientSlot &slot = _clients[i];
+        if (slot.id == 0 || !(slot.topics & (1 << TOPIC_TRACE))) continue;
+        if (!_due(slot, TOPIC_TRACE, now)) {
+            slot.traceDropped++;
+            continue;
+        }
+        
+        if (trace.isNull()) {
+            trace["type"] = "trace";
+            trace["source"] = SOURCES[context.source];
+            trace["command"] = command;
+            trace["result"] = RESULTS[result];
+            trace["us"] = elapsed;
+        }
+        trace["dropped"] = slot.traceDropped;
+        slot.traceDropped = 0;
+        slot.lastPush[TOPIC_TRACE] = now;
+        _sendJson(slot.id, trace);
+    }
+}
+
+// ============================================================================
+// Client Send Queues
+// ============================================================================
+
+void WiFiManager::_queueFrame(ClientSlot &slot, const uint8_t *data, size_t length, bool binary) {
+    if (slot.closing) {
+        return;
+    }
+    
+    // Replies are never dropped: a client that cannot hold one more is closed
+    if (slot.used + 2 + length > WS_CLIENT_QUEUE_SIZE) {
+        _closeClient(slot, "send queue full");
+        return;
+    }
+    
+    uint16_t header = length | (binary ? WS_FRAME_BINARY : 0);
+    uint8_t prefix[2] = {(uint8_t)(header >> 8), (uint8_t)(header & 0xFF)};
+    size_t tail = (slot.head + slot.used) % WS_CLIENT_QUEUE_SIZE;
+    for (size_t i = 0; i < 2 + length; i++) {
+        slot.queue[tail] = (i < 2) ? prefix[i] : data[i - 2];
+        tail = (tail + 1) % WS_CLIENT_QUEUE_SIZE;
+    }
+    slot.used += 2 + length;
+}
+
+void WiFiManager::_queueFrameAll(const uint8_t *data, size_t length, bool binary) {
+    for (uint8_t slot = 0; slot < WS_MAX_CLIENTS; slot++) {
+        if (_clients[slot].id != 0) {
+            _queueFrame(_clients[slot], data, length, binary);
+        }
+    }
+}
+
+size_t WiFiManager::_dequeueFrame(ClientSlot &slot, uint8_t *buffer, bool &binary) {
+    uint16_t header = (slot.queue[slot.head] << 8) | slot.queue[(slot.head + 1) % WS_CLIENT_QUEUE_SIZE];
+    size_t length = header & ~WS_FRAME_BINARY;
+    binary = (header & WS_FRAME_BINARY) != 0;
     
-    return jsonString;
+    size_t index = (slot.head + 2) % WS_CLIENT_QUEUE_SIZE;
+    for (size_t i = 0; i < length; i++) {
+        buffer[i] = slot.queue[index];
+        index = (index + 1) % WS_CLIENT_QUEUE_SIZE;
+    }
+    slot.head = index;
+    slot.used -= 2 + length;
+    return length;
 }
 
+bool WiFiManager::_sendNext(ClientSlot &slot, unsigned long now) {
+    // Replies first (a hello must precede the snapshot it announces), then
+    // the latest status, WiFi status and position sample as each topic's
+    // rate allows
+    if (slot.used > 0) {
+        bool binary;
+        size_t length = _dequeueFrame(slot, (uint8_t*)_sendBuffer, binary);
+        if (binary) {
+            _webSocket->binary(slot.id, (uint8_t*)_sendBuffer, length);
+        } else {
+            _webSocket->text(slot.id, _sendBuffer, length);
+        }
+        return true;
+    }
+    
+    if (slot.status != STATUS_NONE && _due(slot, TOPIC_STATUS, now)) {
+        StatusPending status = slot.status;
+        slot.status = STATUS_NONE;
+        slot.lastPush[TOPIC_STATUS] = now;
+        if (slot.binary) {
+            uint8_t frame[FRAME_STATUS_SIZE];
+            BinaryProtocol::encodeStatus(frame, _lastStatus, _statusSeq);
+            _webSocket->binary(slot.id, frame, sizeof(frame));
+        } else if (status == STATUS_DELTA) {
+            _webSocket->text(slot.id, _statusBuffer, _statusLength);
+        } else {
+            size_t length = _formatSnapshot(_sendBuffer, sizeof(_sendBuffer));
+            if (length > 0) {
+                _webSocket->text(slot.id, _sendBuffer, length);
+            }
+        }
+        return true;
+    }
+    
+    if (_due(slot, TOPIC_WIFI, now)) {
+        slot.lastPush[TOPIC_WIFI] = now;
+        JsonDocument doc(&auxJsonArena);
+        getWiFiStatus(doc);
+        size_t length = serializeJson(doc, _sendBuffer, sizeof(_sendBuffer));
+        _webSocket->text(slot.id, _sendBuffer, length);
+        return true;
+    }
+    
+    if (slot.position && _due(slot, TOPIC_TELEMETRY, now)) {
+        slot.position = false;
+        slot.lastPush[TOPIC_TELEMETRY] = now;
+        if (slot.binary) {
+            _webSocket->binary(slot.id, _positionFrame, sizeof(_positionFrame));
+        } else {
+            int length = snprintf(_sendBuffer, sizeof(_sendBuffer),
+                                  "{\"type\":\"position\",\"time\":%lu,\"position\":%lu,\"moving\":%s}",
+                                  (unsigned long)_sampleTime, (unsigned long)_samplePosition,
+                                  _sampleMoving ? "true" : "false");
+            _webSocket->text(slot.id, _sendBuffer, length);
+        }
+        return true;
+    }
+    
+    return false;
+}
+
+bool WiFiManager::_hasDue(const ClientSlot &slot, unsigned long now) {
+    return slot.used > 0 ||
+           (slot.status != STATUS_NONE && _due(slot, TOPIC_STATUS, now)) ||
+           _due(slot, TOPIC_WIFI, now) ||
+           (slot.position && _due(slot, TOPIC_TELEMETRY, now));
+}
+
+bool WiFiManager::_due(const ClientSlot &slot, Topic topic, unsigned long now) {
+    return (slot.topics & (1 << topic)) && now - slot.lastPush[topic] >= slot.interval[topic];
+}
+
+void WiFiManager::_pumpClients() {
+    // Hand frames to the library only while it has room for this client,
+    // so a slow link backs up here instead of in the AUX task or in other clients
+    unsigned long now = millis();
+    for (uint8_t i = 0; i < WS_MAX_CLIENTS; i++) {
+        ClientSlot &slot = _clients[i];
+        if (slot.id == 0 || slot.closing) continue;
+        
+        bool sent = false;
+        while (_webSocket->availableForWrite(slot.id) && _sendNext(slot, now)) {
+            sent = true;
+        }
+        
+        if (!_hasDue(slot, now) || sent) {
+            slot.blockedSince = 0;
+        } else if (slot.blockedSince == 0) {
+            slot.blockedSince = now | 1;  // Never 0, which means keeping up
+        } else if (now - slot.blockedSince > WS_LAG_TIMEOUT) {
+            _closeClient(slot, "lagging");
+        }
+    }
+}
+
+void WiFiManager::_closeClient(ClientSlot &slot, const char *reason) {
+    // Slot is freed by the disconnect event that follows
+    Serial.printf("INFO: Closing WebSocket client %lu (%s)\n", (unsigned long)slot.id, reason);
+    slot.closing = true;
+    slot.used = 0;
+    slot.status = STATUS_NONE;
+    slot.position = false;
+    _webSocket->close(slot.id);
+}
+
+
 void WiFiManager::_onWiFiEvent(WiFiEvent_t event) {
     switch (event) {
         case ARDUINO_EVENT_WIFI_STA_CONNECTED:
@@ -11,10 +11,15 @@
 #include <WiFi.h>
 #include <Preferences.h>
 #include <ESPAsyncWebServer.h>
-#include <WebSocketsServer.h>
 #include <ArduinoJson.h>
-#include <SPIFFS.h>
 #include <ESPmDNS.h>
+#include "focuser_status.h"
+#include "binary_protocol.h"
+#include "web_assets.h"
+#include "json_arena.h"
+#include "command_registry.h"
+#include "seqlock.h"
+#include "scheduler.h"
 
 // WiFi Configuration
 #define WIFI_AP_SSID "Celestron-Focuser"
@@ -24,7 +29,38 @@
 
 // Web Server Configuration
 #define WEB_SERVER_PORT 80
-#define WEBSOCKET_PORT 81
+#define WEBSOCKET_PATH "/ws"            // Served by the web server on WEB_SERVER_PORT
+#define EVENTS_PATH "/api/events"       // Server-Sent Events status stream
+
+// WebSocket and REST events are queued by the TCP task and handled on the AUX task
+#define WS_MAX_CLIENTS 8
+#define WEB_EVENT_QUEUE_LENGTH 16
+#define WEB_LIFECYCLE_QUEUE_LENGTH 64   // Connects/disconnects: every lwIP TCP socket (16) churning twice per pass
+#define WEB_MESSAGE_MAX_LEN 256
+
+// Per-client outbound queue: replies and events wait here until the library
+// can take them (WS_MAX_QUEUED_MESSAGES in flight, see platformio.ini)
+#define WS_CLIENT_QUEUE_SIZE 1280       // Bytes of queued replies per client
+#define WS_LAG_TIMEOUT 5000             // Close clients that accept nothing for this long (ms)
+#define WS_FRAME_BINARY 0x8000          // Queue header flag; low bits are the length
+
+// Long-running commands awaiting their completed/failed event
+#define WS_MAX_OPERATIONS 4
+#define WS_REQUEST_ID_SIZE 24           // Client request id as JSON text (number or short string)
+
+// Topic subscriptions (rates are maximums in Hz; 0 unsubscribes)
+#define TOPIC_MAX_RATE 1000             // At or above this every update is sent
+#define TOPIC_WIFI_MIN_INTERVAL 1000    // WiFi status is read on demand: at most 1 Hz
+
+// REST API (requests are paused until the AUX task has run the command)
+#define REST_MAX_PENDING 4
+#define REST_MAX_PARAMS 5
+
+// Status broadcast buffer (serialized once per change, sent to every client)
+#define STATUS_BUFFER_SIZE 160
+
+// Command responses are serialized here before being handed to a client
+#define WEB_SEND_BUFFER_SIZE 1024
 
 // Preferences keys
 #define PREF_NAMESPACE "wifi_config"
@@ -38,6 +74,75 @@
 // Connection timeout (seconds)
 #define WIFI_CONNECT_TIMEOUT 30
 #define WIFI_RECONNECT_DELAY 5000
+#define WIFI_CONNECT_POLL 500           // Connection status checks while connecting (ms)
+#define WIFI_MODE_CHANGE_DELAY 1000     // Lets the config reply go out before switching
+
+/**
+ * Queued Web Event
+ * Copied by value into a FreeRTOS queue so the TCP task never blocks on
+ * (or races with) focuser commands executing in the main loop
+ */
+struct WebEvent {
+    enum Type : uint8_t { CONNECT, DISCONNECT, MESSAGE, HTTP_REQUEST };
+    
+    Type type;
+    uint32_t clientId;          // WebSocket client id, or pending REST slot
+    uint16_t length;
+    char payload[WEB_MESSAGE_MAX_LEN];
+};
+
+/**
+ * Queued WebSocket Connect/Disconnect
+ * Kept apart from WebEvent so a backlog of messages can never crowd them
+ * out: a lost disconnect would hold its ClientSlot forever, a lost connect
+ * would leave the client without one
+ */
+struct WebLifecycleEvent {
+    WebEvent::Type type;        // CONNECT or DISCONNECT
+    uint32_t clientId;
+};
+
+/**
+ * WebSocket Topics
+ * Clients start subscribed to status (binary clients also to telemetry)
+ */
+enum Topic : uint8_t {
+    TOPIC_STATUS,               // focuserStatus snapshots and deltas
+    TOPIC_WIFI,                 // WiFi status
+    TOPIC_TELEMETRY,            // Position samples while moving
+    TOPIC_TRACE,                // One line per executed web command
+    TOPIC_COUNT
+};
+
+/**
+ * Deferred Request Completion
+ * Called on the AUX task with the command result to send the HTTP reply
+ */
+typedef void (*DeferredCompletion)(AsyncWebServerRequest *request, JsonDocument &command, CommandResult result,
+                                   JsonDocument &response, uint32_t tag);
+
+/**
+ * Status Snapshot
+ * Full status message SSE clients start from; published by the AUX task
+ * and copied out on the TCP task without a lock
+ */
+struct StatusSnapshot {
+    char text[STATUS_BUFFER_SIZE];
+    size_t length;
+    uint32_t seq;
+};
+
+/**
+ * REST Route
+ * Maps an endpoint onto a focuser command; listed request parameters
+ * become fields of the command message
+ */
+struct RestRoute {
+    const char* path;
+    WebRequestMethodComposite method;
+    const char* command;
+    const char* params[REST_MAX_PARAMS];
+};
 
 /**
  * WiFi Manager Class
@@ -51,12 +156,15 @@ public:
     
     // Initialization
     bool begin();
-    void handle();
+    void handle();                  // loop(): client cleanup, mode changes, reconnects
+    void setScheduler(Scheduler *scheduler);    // loop()'s scheduler, before begin()
+    void processEvents();           // AUX task: queued commands and client pushes
+    void setWorkerTask(TaskHandle_t task);
     
     // WiFi Control
     bool startAP();
     bool startStation();
-    bool connectToWiFi();
+    bool connectToWiFi();           // Starts connecting; completes from the scheduler
     void disconnect();
     
     // Configuration Management
@@ -71,14 +179,35 @@ public:
     String getIPAddress();
     String getSSID();
     String getHostname();
+    void getWiFiStatus(JsonDocument &doc);
     
     // Web Interface
     void setupWebServer();
-    void handleWebSocketMessage(uint8_t num, uint8_t *payload, size_t length);
+    void handleWebSocketMessage(uint32_t clientId, uint8_t *payload, size_t length);
+    
+    // WiFi Commands (mode changes run from handle() once the reply is sent)
+    void configureWiFi(const char* ssid, const char* password, const char* hostname);
+    void resetWiFi();
+    void negotiateProtocol(uint32_t clientId, const char* protocol);
+    
+    // Deferred Web Requests (TCP task hands a command to the AUX task; 0 or an HTTP error code)
+    AsyncWebServer* getWebServer();
+    int deferRequest(AsyncWebServerRequest *request, const JsonDocument &command,
+                     DeferredCompletion completion, uint32_t tag);
     
     // Focuser Control via WebSocket
-    void setFocuserCallback(std::function<bool(String, JsonDocument&)> callback);
-    void sendFocuserStatus(uint8_t num, bool connected, uint32_t position, uint32_t target, uint8_t speed, bool moving);
+    void setCommandRegistry(CommandRegistry *registry);
+    void broadcastFocuserStatus(const FocuserStatus& status);
+    void sendFocuserSnapshot(uint32_t clientId);
+    void broadcastPositionSample(uint32_t position, bool moving);
+    void broadcastMoveComplete(uint32_t position, uint32_t target);
+    bool hasTelemetryClients();
+    
+    // Topic Subscriptions (topics maps names to a maximum rate in Hz)
+    bool subscribe(uint32_t clientId, JsonObjectConst topics, JsonDocument &response);
+    
+    // Long-running command completion (group is CMD_FLAG_MOTION or CMD_FLAG_CALIBRATION)
+    void finishOperations(uint8_t group, bool success, const char* message, uint32_t position);
     
     // mDNS Support
     bool startmDNS();
@@ -102,7 +231,74 @@ private:
     
     // Web Server
     AsyncWebServer* _webServer;
-    WebSocketsServer* _webSocketServer;
+    AsyncWebSocket* _webSocket;
+    AsyncEventSource* _events;
+    QueueHandle_t _webEvents;
+    QueueHandle_t _lifecycleEvents;
+    TaskHandle_t _worker;                   // Woken when an event is queued
+    
+    // Last pushed focuser status; changes go out as sequenced deltas
+    FocuserStatus _lastStatus;
+    bool _hasStatus;
+    uint32_t _statusSeq;
+    char _statusBuffer[STATUS_BUFFER_SIZE];
+    size_t _statusLength;
+    
+    // Latest full snapshot for SSE clients connecting on the TCP task
+    Seqlock<StatusSnapshot> _snapshot;
+    
+    // Serialized command responses and dequeued frames (AUX task only)
+    char _sendBuffer[WEB_SEND_BUFFER_SIZE];
+    uint8_t _positionFrame[FRAME_POSITION_SIZE];
+    
+    // Connected clients as seen from the AUX task (id 0 = free slot)
+    enum StatusPending : uint8_t { STATUS_NONE, STATUS_DELTA, STATUS_SNAPSHOT };
+    struct ClientSlot {
+        uint32_t id;
+        bool binary;            // Negotiated the binary protocol
+        bool closing;           // Closed for lagging; waiting for the disconnect
+        StatusPending status;   // Latest status only: superseded, never queued
+        bool position;          // Latest position sample only (telemetry subscribers)
+        unsigned long blockedSince;  // When the client last stopped accepting (0 = keeping up)
+        
+        // Subscriptions: bit per Topic, each with its own minimum interval
+        uint8_t topics;
+        uint16_t interval[TOPIC_COUNT];     // ms between pushes (0 = every update)
+        unsigned long lastPush[TOPIC_COUNT];
+        uint16_t traceDropped;  // Trace lines skipped by the rate limit
+        
+        // Replies, acks and events: never dropped (byte ring of
+        // 2 byte headers, length plus WS_FRAME_BINARY flag, and payloads)
+        uint16_t head;
+        uint16_t used;
+        uint8_t queue[WS_CLIENT_QUEUE_SIZE];
+    };
+    ClientSlot _clients[WS_MAX_CLIENTS];
+    
+    // Latest position sample for JSON telemetry subscribers
+    uint32_t _samplePosition;
+    bool _sampleMoving;
+    uint32_t _sampleTime;
+    
+    // Accepted long-running commands (clientId 0 = free slot)
+    struct Operation {
+        uint32_t clientId;
+        uint8_t group;
+        const CommandDef* command;
+        char id[WS_REQUEST_ID_SIZE];    // Empty if the client sent no id
+        uint32_t binaryId;              // Request id as carried in binary acks
+    };
+    Operation _operations[WS_MAX_OPERATIONS];
+    
+    // Paused HTTP requests awaiting their command result
+    struct PendingRequest {
+        AsyncWebServerRequestPtr request;
+        DeferredCompletion completion;
+        uint32_t tag;
+        bool used;
+    };
+    PendingRequest _pending[REST_MAX_PENDING];
+    SemaphoreHandle_t _pendingLock;
     
     // Preferences
     Preferences _preferences;
@@ -110,16 +306,55 @@ private:
     // Callbacks
     std::function<void()> _onConnected;
     std::function<void()> _onDisconnected;
-    std::function<bool(String, JsonDocument&)> _focuserCallback;
+    
+    // Commands shared with the serial front end
+    CommandRegistry* _commands;
+    
+    // Deferred AP/station switch requested by a WiFi command
+    enum ModeChange : uint8_t { MODE_CHANGE_NONE, MODE_CHANGE_STATION, MODE_CHANGE_AP };
+    volatile ModeChange _modeChange;        // Requested on the AUX task, run from loop()
+    
+    // Station connection in progress (loop() only)
+    Scheduler* _scheduler;
+    bool _connecting;
+    bool _fallbackToAP;                     // Boot attempt: start AP mode if it fails
+    uint32_t _connectAttempt;               // Superseded attempts stop polling
+    unsigned long _connectStart;
     
     // Internal Methods
     void _setupWebRoutes();
-    void _handleRoot(AsyncWebServerRequest *request);
+    void _setupFocuserRoutes();
+    void _handleFocuserRequest(AsyncWebServerRequest *request, const RestRoute &route);
+    void _completeFocuserRequest(const WebEvent &event);
+    static void _sendRestResponse(AsyncWebServerRequest *request, JsonDocument &command, CommandResult result,
+                                  JsonDocument &response, uint32_t tag);
+    void _handleAsset(AsyncWebServerRequest *request, const WebAsset &asset);
     void _handleWiFiConfig(AsyncWebServerRequest *request);
     void _handleStatus(AsyncWebServerRequest *request);
     void _handleNotFound(AsyncWebServerRequest *request);
-    String _getWiFiStatusJSON();
+    void _sendJson(uint32_t clientId, const JsonDocument &doc);
+    void _startOperation(uint32_t clientId, const CommandDef &command, JsonVariantConst id);
+    void _sendOperationEvent(const Operation &operation, bool success, const char* message, uint32_t position);
+    void _queueFrame(ClientSlot &slot, const uint8_t *data, size_t length, bool binary);
+    void _queueFrameAll(const uint8_t *data, size_t length, bool binary);
+    size_t _dequeueFrame(ClientSlot &slot, uint8_t *buffer, bool &binary);
+    bool _sendNext(ClientSlot &slot, unsigned long now);
+    bool _hasDue(const ClientSlot &slot, unsigned long now);
+    static bool _due(const ClientSlot &slot, Topic topic, unsigned long now);
+    void _traceCommand(const CommandContext &context, const char* command, CommandResult result, uint32_t elapsed);
+    void _pumpClients();
+    void _closeClient(ClientSlot &slot, const char *reason);
+    void _onWebEvent(AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t length);
+    void _processWebEvents();
+    void _rejectMessage(AsyncWebSocketClient *client, const uint8_t *data, size_t length);
+    size_t _formatSnapshot(char* buffer, size_t size);
+    size_t _formatDelta(const FocuserStatus& status, char* buffer, size_t size);
+    void _onEventsConnect(AsyncEventSourceClient *client);
+    ClientSlot* _findClient(uint32_t clientId);
+    void _setBinaryClient(uint32_t clientId, bool binary);
+    bool _isBinaryClient(uint32_t clientId);
     void _onWiFiEvent(WiFiEvent_t event);
+    void _checkConnection(uint32_t attempt);
     
 };
 
@@ -0,0 +1,221 @@
+/*
+    Alpaca Protocol Test (host)
+    Conformance sequences for the Alpaca server's parameter parsing, error
+    mapping and reply building, run the way the server runs them
+
+    Copyright (C) 2024
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "alpaca_protocol.h"
+
+// ============================================================================
+// Test Device
+// ============================================================================
+
+// The server's flow without the web server: check the request, run the
+// command (every focuser command succeeds here), then map the result
+struct Device {
+    AlpacaSession session;
+    bool focuserConnected;
+    uint32_t target;
+
+    Device() : focuserConnected(true), target(0) {}
+
+    bool getConnected() const {
+        return session.connected(focuserConnected);
+    }
+
+    AlpacaOutcome putConnected(const char* text) {
+        AlpacaArgument argument;
+        AlpacaOutcome outcome = alpacaCheckRequest(ALPACA_PARAM_BOOL, text, false, session.isOpen(),
+                                                   focuserConnected, argument);
+        if (outcome.http != ALPACA_HTTP_OK || outcome.error != ALPACA_OK) {
+            return outcome;
+        }
+        if (!argument.flag) {
+            session.close();
+            return outcome;
+        }
+        focuserConnected = true;
+        outcome = alpacaCommandOutcome(true, false, nullptr, true);
+        if (outcome.error == ALPACA_OK) {
+            session.open();
+        }
+        return outcome;
+    }
+
+    AlpacaOutcome putMove(const char* text) {
+        AlpacaArgument argument;
+        AlpacaOutcome outcome = alpacaCheckRequest(ALPACA_PARAM_INT, text, true, session.isOpen(),
+                                                   focuserConnected, argument);
+        if (outcome.http != ALPACA_HTTP_OK || outcome.error != ALPACA_OK) {
+            return outcome;
+        }
+        target = argument.number;
+        return alpacaCommandOutcome(true, false, nullptr, true);
+    }
+
+    AlpacaOutcome getPosition() {
+        AlpacaArgument argument;
+        AlpacaOutcome outcome = alpacaCheckRequest(ALPACA_PARAM_NONE, nullptr, true, session.isOpen(),
+                                                   focuserConnected, argument);
+        if (outcome.http != ALPACA_HTTP_OK || outcome.error != ALPACA_OK) {
+            return outcome;
+        }
+        return alpacaCommandOutcome(true, false, nullptr, true);
+    }
+};
+
+static bool isAnswer(const AlpacaOutcome &outcome, uint16_t error) {
+    return outcome.http == ALPACA_HTTP_OK && outcome.error == error;
+}
+
+static bool isBadRequest(const AlpacaOutcome &outcome) {
+    return outcome.http == ALPACA_HTTP_BAD_REQUEST;
+}
+
+// ============================================================================
+// Sequences
+// ============================================================================
+
+// Connected=true, Connected=false and the state GET connected reports
+static bool runConnectSequence() {
+    Device device;
+    bool ok = !device.getConnected();
+    ok = ok && isAnswer(device.putConnected("true"), ALPACA_OK) && device.getConnected();
+    ok = ok && isAnswer(device.putConnected("True"), ALPACA_OK) && device.getConnected();
+    ok = ok && isAnswer(device.putConnected("false"), ALPACA_OK) && !device.getConnected();
+
+    // Disconnecting leaves the focuser to other users
+    ok = ok && device.focuserConnected;
+    ok = ok && isAnswer(device.putConnected("FALSE"), ALPACA_OK) && !device.getConnected();
+    ok = ok && isAnswer(device.putConnected("true"), ALPACA_OK) && device.getConnected();
+
+    // The focuser dropping off the bus shows up too
+    device.focuserConnected = false;
+    return ok && !device.getConnected();
+}
+
+// Missing or malformed parameters are HTTP 400, not Alpaca errors
+static bool runBadRequests() {
+    Device device;
+    device.putConnected("true");
+    return isBadRequest(device.putConnected(nullptr)) &&
+           isBadRequest(device.putConnected("")) &&
+           isBadRequest(device.putConnected("yes")) &&
+           isBadRequest(device.putConnected("1")) &&
+           isBadRequest(device.putMove(nullptr)) &&
+           isBadRequest(device.putMove("")) &&
+           isBadRequest(device.putMove("12x")) &&
+           isBadRequest(device.putMove("1.5")) &&
+           isBadRequest(device.putMove("position")) &&
+           device.getConnected() && device.target == 0;
+}
+
+// Well-formed but unusable values are InvalidValue (0x401)
+static bool runInvalidValues() {
+    Device device;
+    device.putConnected("true");
+    return isAnswer(device.putMove("-1"), ALPACA_INVALID_VALUE) &&
+           isAnswer(device.putMove("-12000"), ALPACA_INVALID_VALUE) &&
+           isAnswer(device.putMove("4294967296"), ALPACA_INVALID_VALUE) &&
+           isAnswer(device.putMove("99999999999999999999"), ALPACA_INVALID_VALUE) &&
+           device.target == 0 &&
+           isAnswer(device.putMove("0"), ALPACA_OK) && device.target == 0 &&
+           isAnswer(device.putMove("12000"), ALPACA_OK) && device.target == 12000;
+}
+
+// NotConnected (0x407) before Connected=true, after Connected=false and
+// while the focuser is offline
+static bool runNotConnected() {
+    Device device;
+    bool ok = isAnswer(device.getPosition(), ALPACA_NOT_CONNECTED) &&
+              isAnswer(device.putMove("100"), ALPACA_NOT_CONNECTED);
+
+    // Checked before the parameter, like the server
+    ok = ok && isAnswer(device.putMove("-1"), ALPACA_NOT_CONNECTED);
+
+    ok = ok && isAnswer(device.putConnected("true"), ALPACA_OK) &&
+         isAnswer(device.getPosition(), ALPACA_OK) &&
+         isAnswer(device.putMove("100"), ALPACA_OK) && device.target == 100;
+
+    device.focuserConnected = false;
+    ok = ok && isAnswer(device.putMove("200"), ALPACA_NOT_CONNECTED) && device.target == 100;
+
+    device.focuserConnected = true;
+    ok = ok && isAnswer(device.putConnected("false"), ALPACA_OK) &&
+         isAnswer(device.getPosition(), ALPACA_NOT_CONNECTED) &&
+         isAnswer(device.putMove("300"), ALPACA_NOT_CONNECTED) && device.target == 100;
+    return ok;
+}
+
+// Registry results to Alpaca errors
+static bool runErrorMapping() {
+    AlpacaOutcome invalid = alpacaCommandOutcome(false, true, "Target outside limits", true);
+    AlpacaOutcome invalidDefault = alpacaCommandOutcome(false, true, nullptr, true);
+    return isAnswer(alpacaCommandOutcome(true, false, nullptr, true), ALPACA_OK) &&
+           isAnswer(invalid, ALPACA_INVALID_VALUE) && strcmp(invalid.message, "Target outside limits") == 0 &&
+           isAnswer(invalidDefault, ALPACA_INVALID_VALUE) && strcmp(invalidDefault.message, "Invalid value") == 0 &&
+           isAnswer(alpacaCommandOutcome(false, false, nullptr, true), ALPACA_UNSPECIFIED_ERROR) &&
+           isAnswer(alpacaCommandOutcome(true, false, nullptr, false), ALPACA_NOT_IMPLEMENTED);
+}
+
+// ClientTransactionID comes back unchanged, 0 when absent or malformed
+static bool runTransactionEcho() {
+    char reply[256];
+    bool ok = alpacaParseTransaction("42") == 42 &&
+              alpacaParseTransaction("4294967295") == 4294967295UL &&
+              alpacaParseTransaction(nullptr) == 0 &&
+              alpacaParseTransaction("") == 0 &&
+              alpacaParseTransaction("-1") == 0 &&
+              alpacaParseTransaction("12abc") == 0 &&
+              alpacaParseTransaction("4294967296") == 0;
+
+    ok = ok && alpacaBuildReply(reply, sizeof(reply), alpacaParseTransaction("42"), 7, ALPACA_OK, "", "true") > 0 &&
+         strcmp(reply, "{\"Value\":true,\"ClientTransactionID\":42,\"ServerTransactionID\":7,"
+                       "\"ErrorNumber\":0,\"ErrorMessage\":\"\"}") == 0;
+    ok = ok && alpacaBuildReply(reply, sizeof(reply), 4294967295UL, 8, ALPACA_NOT_CONNECTED, "Not connected",
+                                nullptr) > 0 &&
+         strcmp(reply, "{\"ClientTransactionID\":4294967295,\"ServerTransactionID\":8,"
+                       "\"ErrorNumber\":1031,\"ErrorMessage\":\"Not connected\"}") == 0;
+    return ok;
+}
+
+// Messages are escaped and replies that do not fit are refused whole
+static bool runReplyBuilding() {
+    char reply[128];
+    size_t length = alpacaBuildReply(reply, sizeof(reply), 1, 2, ALPACA_INVALID_VALUE, "say \"hi\"\\\n", "[1]");
+    bool ok = length == strlen(reply) &&
+              strcmp(reply, "{\"Value\":[1],\"ClientTransactionID\":1,\"ServerTransactionID\":2,"
+                            "\"ErrorNumber\":1025,\"ErrorMessage\":\"say \\\"hi\\\"\\\\\\u000a\"}") == 0;
+
+    // Exactly fitting (with the terminator) works, one byte less does not
+    char exact[sizeof(reply)];
+    ok = ok && alpacaBuildReply(exact, length + 1, 1, 2, ALPACA_INVALID_VALUE, "say \"hi\"\\\n", "[1]") == length;
+    ok = ok && alpacaBuildReply(exact, length, 1, 2, ALPACA_INVALID_VALUE, "say \"hi\"\\\n", "[1]") == 0;
+    return ok && alpacaBuildReply(reply, 0, 1, 2, ALPACA_OK, "", nullptr) == 0;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static int report(const char* name, bool ok) {
+    printf("%s: %s\n", ok ? "PASS" : "FAIL", name);
+    return ok ? 0 : 1;
+}
+
+int main() {
+    int failures = 0;
+    failures += report("connect/disconnect sequence", runConnectSequence());
+    failures += report("missing or invalid parameters are HTTP 400", runBadRequests());
+    failures += report("negative or oversized Position is InvalidValue", runInvalidValues());
+    failures += report("NotConnected until connected", runNotConnected());
+    failures += report("command results to Alpaca errors", runErrorMapping());
+    failures += report("ClientTransactionID echoed", runTransactionEcho());
+    failures += report("reply escaping and overflow", runReplyBuilding());
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,67 @@
+/*
+    SPSC Ring Throughput Benchmark (host)
+    Bytes through a ring the size of the AUX receive ring, single and bulk
+
+    Copyright (C) 2024
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include "spsc_ring.h"
+
+#define BENCH_RING_SIZE 256             // AUX_RX_RING_SIZE
+#define BENCH_CHUNK 32                  // AuxPort::_onReceive chunk
+
+static SpscRing<uint8_t, BENCH_RING_SIZE> ring;
+
+// ============================================================================
+// Runs
+// ============================================================================
+
+static double run(uint32_t count, size_t chunk) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread producer([count, chunk]() {
+        uint8_t buffer[BENCH_CHUNK];
+        for (size_t i = 0; i < sizeof(buffer); i++) {
+            buffer[i] = (uint8_t)i;
+        }
+        for (uint32_t sent = 0; sent < count; ) {
+            size_t length = std::min((size_t)(count - sent), chunk);
+            size_t pushed = (chunk == 1) ? (ring.push(buffer[0]) ? 1 : 0) : ring.push(buffer, length);
+            sent += pushed;
+            if (pushed == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint8_t buffer[BENCH_CHUNK];
+    uint32_t received = 0;
+    while (received < count) {
+        size_t popped = (chunk == 1) ? (ring.pop(buffer[0]) ? 1 : 0) : ring.pop(buffer, chunk);
+        received += popped;
+        if (popped == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return count / elapsed.count();
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    uint32_t count = (argc > 1) ? strtoul(argv[1], nullptr, 0) : 50000000;
+
+    printf("SPSC ring, %d bytes, %lu bytes per run\n", BENCH_RING_SIZE, (unsigned long)count);
+    printf("  single push/pop:   %8.1f MB/s\n", run(count, 1) / 1e6);
+    printf("  bulk %2d byte chunks: %6.1f MB/s\n", BENCH_CHUNK, run(count, BENCH_CHUNK) / 1e6);
+    return EXIT_SUCCESS;
+}
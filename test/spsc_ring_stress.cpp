@@ -0,0 +1,144 @@
+/*
+    SPSC Ring Stress Test (host)
+    One producer and one consumer thread hammer the ring; every item must
+    arrive once, in order and untorn
+
+    Copyright (C) 2024
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include "spsc_ring.h"
+
+// ============================================================================
+// Test Items
+// ============================================================================
+
+// Wider than a word so a torn copy shows up as a bad check value
+struct Item {
+    uint32_t sequence;
+    uint32_t payload[5];
+    uint32_t check;
+};
+
+static Item makeItem(uint32_t sequence) {
+    Item item;
+    item.sequence = sequence;
+    item.check = sequence;
+    for (int i = 0; i < 5; i++) {
+        item.payload[i] = sequence * 2654435761UL + i;
+        item.check ^= item.payload[i];
+    }
+    return item;
+}
+
+static bool checkItem(const Item &item, uint32_t expected) {
+    uint32_t check = item.sequence;
+    for (int i = 0; i < 5; i++) {
+        check ^= item.payload[i];
+    }
+    return item.sequence == expected && item.check == check;
+}
+
+// ============================================================================
+// Scenarios
+// ============================================================================
+
+// Single-item push/pop
+template <size_t Capacity>
+static bool runSingle(uint32_t count) {
+    static SpscRing<Item, Capacity> ring;
+    std::thread producer([count]() {
+        for (uint32_t i = 0; i < count; ) {
+            if (ring.push(makeItem(i))) {
+                i++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    bool ok = true;
+    for (uint32_t expected = 0; expected < count && ok; ) {
+        Item item;
+        if (ring.pop(item)) {
+            ok = checkItem(item, expected++);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    return ok && ring.empty();
+}
+
+// Bulk push/pop with batch sizes that do not divide the capacity
+template <size_t Capacity>
+static bool runBulk(uint32_t count) {
+    static SpscRing<uint32_t, Capacity> ring;
+    std::thread producer([count]() {
+        uint32_t batch[13];
+        for (uint32_t i = 0; i < count; ) {
+            size_t length = 0;
+            for (; length < 1 + i % 13 && i + length < count; length++) {
+                batch[length] = i + length;
+            }
+            size_t pushed = ring.push(batch, length);
+            i += pushed;
+            if (pushed == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    bool ok = true;
+    uint32_t batch[7];
+    for (uint32_t expected = 0; expected < count && ok; ) {
+        size_t popped = ring.pop(batch, 1 + expected % 7);
+        for (size_t i = 0; i < popped && ok; i++) {
+            ok = (batch[i] == expected++);
+        }
+        if (popped == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    return ok && ring.empty();
+}
+
+// Full/empty boundaries over many laps of the masked indices
+static bool runLaps() {
+    SpscRing<uint8_t, 4> ring;
+    for (uint32_t i = 0; i < 0x10000; i++) {
+        if (!ring.push((uint8_t)i) || ring.size() != 1) {
+            return false;
+        }
+        uint8_t value;
+        if (!ring.pop(value) || value != (uint8_t)i) {
+            return false;
+        }
+    }
+    return ring.empty() && ring.push((uint8_t)1) && ring.push((uint8_t)2) && ring.push((uint8_t)3) &&
+           ring.push((uint8_t)4) && !ring.push((uint8_t)5) && ring.size() == 4;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static int report(const char* name, bool ok) {
+    printf("%s: %s\n", ok ? "PASS" : "FAIL", name);
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    uint32_t count = (argc > 1) ? strtoul(argv[1], nullptr, 0) : 1000000;
+
+    int failures = 0;
+    failures += report("full/empty over many laps", runLaps());
+    failures += report("single items, capacity 2", runSingle<2>(count / 4));
+    failures += report("single items, capacity 64", runSingle<64>(count));
+    failures += report("bulk, capacity 16", runBulk<16>(count));
+    failures += report("bulk, capacity 256", runBulk<256>(count));
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+"""
+    Web Asset Embedding for ESP32 Celestron Focuser Controller
+
+    Minifies and gzips every file in data/ and writes src/web_assets_data.cpp
+    with flash-resident byte arrays and strong ETags (content hashes).
+
+    Runs automatically as a PlatformIO pre-build script, or by hand:
+        python3 tools/embed_assets.py
+
+    Copyright (C) 2024
+"""
+
+import gzip
+import hashlib
+import os
+import re
+
+CONTENT_TYPES = {
+    ".html": "text/html",
+    ".css": "text/css",
+    ".js": "application/javascript",
+    ".json": "application/json",
+    ".svg": "image/svg+xml",
+    ".ico": "image/x-icon",
+    ".png": "image/png",
+}
+
+TEXT_TYPES = (".html", ".css", ".js", ".json", ".svg")
+
+
+def minify(text):
+    """Conservative minification: safe for inline <style> and <script>.
+
+    Drops HTML comments, CSS block comments, whole-line // comments,
+    indentation and blank lines. Line breaks are kept so JavaScript
+    automatic semicolon insertion still behaves.
+    """
+    text = re.sub(r"<!--.*?-->", "", text, flags=re.S)
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    lines = []
+    for line in text.splitlines():
+        line = line.strip()
+        if not line or line.startswith("//"):
+            continue
+        lines.append(line)
+    return "\n".join(lines)
+
+
+def c_identifier(path):
+    return "ASSET_" + re.sub(r"[^A-Za-z0-9]", "_", path.strip("/")).upper()
+
+
+def build_assets(project_dir):
+    data_dir = os.path.join(project_dir, "data")
+    output = os.path.join(project_dir, "src", "web_assets_data.cpp")
+
+    assets = []
+    for root, _, files in os.walk(data_dir):
+        for name in sorted(files):
+            ext = os.path.splitext(name)[1].lower()
+            if ext not in CONTENT_TYPES:
+                continue
+
+            source = os.path.join(root, name)
+            with open(source, "rb") as f:
+                content = f.read()
+            if ext in TEXT_TYPES:
+                content = minify(content.decode("utf-8")).encode("utf-8")
+
+            # mtime=0 keeps the output (and ETag) identical across builds
+            compressed = gzip.compress(content, compresslevel=9, mtime=0)
+            etag = '"' + hashlib.sha256(compressed).hexdigest()[:16] + '"'
+            path = "/" + os.path.relpath(source, data_dir).replace(os.sep, "/")
+            assets.append((path, CONTENT_TYPES[ext], compressed, etag, len(content)))
+
+    lines = [
+        "// Generated by tools/embed_assets.py from data/ - do not edit",
+        "",
+        '#include "web_assets.h"',
+        "",
+    ]
+    for path, _, compressed, _, size in assets:
+        lines.append("// %s: %d bytes minified, %d bytes gzipped" % (path, size, len(compressed)))
+        lines.append("static const uint8_t %s[] PROGMEM = {" % c_identifier(path))
+        for i in range(0, len(compressed), 16):
+            chunk = compressed[i:i + 16]
+            lines.append("    " + ", ".join("0x%02x" % b for b in chunk) + ",")
+        lines.append("};")
+        lines.append("")
+
+    lines.append("const WebAsset WEB_ASSETS[] = {")
+    for path, content_type, compressed, etag, _ in assets:
+        lines.append('    {"%s", "%s", %s, %d, "%s"},' % (
+            path, content_type, c_identifier(path), len(compressed), etag.replace('"', '\\"')))
+    lines.append("};")
+    lines.append("")
+    lines.append("const size_t WEB_ASSET_COUNT = sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]);")
+    lines.append("")
+    generated = "\n".join(lines)
+
+    # Only touch the file when the content changed to avoid needless rebuilds
+    if os.path.exists(output):
+        with open(output, "r") as f:
+            if f.read() == generated:
+                return
+    with open(output, "w") as f:
+        f.write(generated)
+    for path, _, compressed, etag, size in assets:
+        print("Embedded %s (%d -> %d bytes, ETag %s)" % (path, size, len(compressed), etag))
+
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO
+    build_assets(env["PROJECT_DIR"])  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        build_assets(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))